@@ -39,6 +39,25 @@ public:
             ColorId bound,
             const std::string& s);
 
+    /**
+     * Compute a clique lower bound and update the bound.
+     *
+     * Nothing is done if the clique lower bound is disabled in the
+     * parameters.
+     *
+     * The bound is computed before returning, since the algorithms use it
+     * right after, to return the initial solution if it is optimal or as the
+     * goal of the local searches. Its computation can be parallelized with
+     * 'clique_lower_bound_number_of_threads' and stops at the time limit.
+     */
+    void update_clique_bound();
+
+    /**
+     * Return 'true' iff the solution is feasible and has as many colors as the
+     * bound, that is, iff it is optimal.
+     */
+    bool optimal() const;
+
     /** Method to call at the end of the algorithm. */
     void end();
 
@@ -11,6 +11,23 @@ struct ColumnGenerationParameters: Parameters
 {
     /** Linear programming solver. */
     columngenerationsolver::SolverName linear_programming_solver = columngenerationsolver::SolverName::CLP;
+
+    /**
+     * Initial solution.
+     *
+     * It may be partial or infeasible. It is repaired and its colors are
+     * added to the initial columns.
+     */
+    Solution* initial_solution = nullptr;
+
+    /**
+     * Maximum number of columns of negative reduced cost returned by each
+     * pricing.
+     *
+     * Returning several diverse columns reduces the number of times the
+     * linear program is solved again.
+     */
+    Counter maximum_number_of_columns_per_pricing = 8;
 };
 
 const Output column_generation_heuristic_greedy(
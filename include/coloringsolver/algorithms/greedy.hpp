@@ -18,19 +18,93 @@ std::ostream& operator<<(std::ostream &os, Ordering ordering);
 
 struct GreedyParameters: Parameters
 {
+    /**
+     * Constructor.
+     *
+     * The clique lower bound is disabled by default since the greedy
+     * algorithms take less time than computing it and it can't make them stop
+     * earlier.
+     */
+    GreedyParameters() { clique_lower_bound = false; }
+
     /** Ordering. */
     Ordering ordering = Ordering::DynamicLargestFirst;
 
     /** Reverse ordering. */
     bool reverse = false;
+
+    /**
+     * Number of threads.
+     *
+     * If it is greater than 1, the vertices are colored speculatively in
+     * parallel following the ordering and the conflicting vertices are
+     * recolored until there is no conflict.
+     */
+    Counter number_of_threads = 1;
 };
 
 const Output greedy(
         const Instance& instance,
         const GreedyParameters& parameters = {});
 
+struct GreedyDsaturParameters: Parameters
+{
+    /**
+     * Constructor.
+     *
+     * See 'GreedyParameters::GreedyParameters()'.
+     */
+    GreedyDsaturParameters() { clique_lower_bound = false; }
+};
+
 const Output greedy_dsatur(
         const Instance& instance,
+        const GreedyDsaturParameters& parameters = {});
+
+struct GreedyJonesPlassmannParameters: Parameters
+{
+    /**
+     * Constructor.
+     *
+     * See 'GreedyParameters::GreedyParameters()'.
+     */
+    GreedyJonesPlassmannParameters() { clique_lower_bound = false; }
+
+    /** Number of threads. */
+    Counter number_of_threads = 1;
+};
+
+/**
+ * Parallel greedy algorithm from "A Parallel Graph Coloring Heuristic" (Jones
+ * et Plassmann, 1993).
+ *
+ * Each vertex receives a random priority. At each round, the uncolored
+ * vertices whose priority is higher than the ones of all their uncolored
+ * neighbors form an independent set; they are colored in parallel with the
+ * smallest color not used by their neighbors.
+ *
+ * The solution only depends on the state of 'generator', not on the number
+ * of threads.
+ */
+const Output greedy_jones_plassmann(
+        const Instance& instance,
+        std::mt19937_64& generator,
+        const GreedyJonesPlassmannParameters& parameters = {});
+
+/**
+ * Build a feasible solution from a partial or infeasible one.
+ *
+ * Conflicting vertices are uncolored by non-increasing number of conflicts
+ * until no conflict remains. The colors of the other vertices are kept, but
+ * renumbered from 0 so that the colors of the returned solution are
+ * consecutive. Then, the uncolored vertices are colored greedily by
+ * non-increasing degree.
+ *
+ * This is used to seed the algorithms with a solution of a previous run, for
+ * example after a small change of the graph.
+ */
+const Output greedy_repair(
+        const Solution& initial_solution,
         const Parameters& parameters = {});
 
 }
@@ -2,6 +2,8 @@
 
 #include "coloringsolver/solution.hpp"
 
+#include <atomic>
+
 namespace coloringsolver
 {
 
@@ -39,6 +41,37 @@ struct LocalSearchRowWeightingParameters: Parameters
 
     /** Initial solution. */
     Solution* initial_solution = nullptr;
+
+    /**
+     * Penalty above which all the penalties are halved.
+     *
+     * The halving is lazy: the penalties added afterwards are doubled, which
+     * takes O(1). The penalties are only really divided, in O(n + m), when these
+     * increments or the sums of penalties get close to overflowing.
+     *
+     * If it is '-1', the penalties are never halved, they are only rescaled
+     * to avoid overflows.
+     */
+    Penalty penalty_decay_threshold = -1;
+
+    /**
+     * Number of colors of the best solution found by the local searches of a
+     * portfolio.
+     *
+     * If it is not 'nullptr', the local search publishes its new best
+     * solutions in it and directly looks for a solution with one color less
+     * than it.
+     */
+    std::atomic<ColorId>* shared_number_of_colors = nullptr;
+
+    /**
+     * Check the incrementally maintained penalty tables against a
+     * computation from scratch after each iteration.
+     *
+     * An exception is thrown if they differ. This makes each iteration take
+     * O(m + n k) and is only meant for tests.
+     */
+    bool check_penalties = false;
 };
 
 const LocalSearchRowWeightingOutput local_search_row_weighting(
@@ -80,6 +113,28 @@ struct LocalSearchRowWeighting2Parameters: Parameters
 
     /** Initial solution. */
     Solution* initial_solution = nullptr;
+
+    /** See 'LocalSearchRowWeightingParameters::penalty_decay_threshold'. */
+    Penalty penalty_decay_threshold = -1;
+
+    /**
+     * Number of colors of the best solution found by the local searches of a
+     * portfolio.
+     *
+     * If it is not 'nullptr', the local search publishes its new best
+     * solutions in it and directly looks for a solution with one color less
+     * than it.
+     */
+    std::atomic<ColorId>* shared_number_of_colors = nullptr;
+
+    /**
+     * Check the incrementally maintained penalty tables against a
+     * computation from scratch after each iteration.
+     *
+     * An exception is thrown if they differ. This makes each iteration take
+     * O(m + n k) and is only meant for tests.
+     */
+    bool check_penalties = false;
 };
 
 const LocalSearchRowWeighting2Output local_search_row_weighting_2(
@@ -87,4 +142,56 @@ const LocalSearchRowWeighting2Output local_search_row_weighting_2(
         std::mt19937_64& generator,
         const LocalSearchRowWeighting2Parameters& parameters = {});
 
+////////////////////////////////////////////////////////////////////////////////
+////////////////////// localsearch_rowweighting_portfolio //////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+struct LocalSearchRowWeightingPortfolioOutput: Output
+{
+    LocalSearchRowWeightingPortfolioOutput(
+            const Instance& instance):
+        Output(instance) { }
+
+
+    /** Number of iterations of all the local searches. */
+    Counter number_of_iterations = 0;
+};
+
+struct LocalSearchRowWeightingPortfolioParameters: Parameters
+{
+    /** Number of threads. */
+    Counter number_of_threads = 1;
+
+    /** Maximum number of iterations of each local search. */
+    Counter maximum_number_of_iterations = -1;
+
+    /** Maximum number of iterations without improvement of each local search. */
+    Counter maximum_number_of_iterations_without_improvement = -1;
+
+    /** Goal. */
+    ColorId goal = 0;
+
+    /** Enable k-core reduction. */
+    bool enable_core_reduction = true;
+
+    /** Penalty decay threshold of each local search. */
+    Penalty penalty_decay_threshold = -1;
+
+    /** Initial solution. */
+    Solution* initial_solution = nullptr;
+};
+
+/**
+ * Run row weighting local searches in parallel.
+ *
+ * The threads alternate between 'local_search_row_weighting' (if the graph is
+ * an AdjacencyListGraph) and 'local_search_row_weighting_2' and each uses its
+ * own seed drawn from 'generator'. As soon as a thread finds a solution with
+ * k colors, all the threads look for a solution with k - 1 colors.
+ */
+const LocalSearchRowWeightingPortfolioOutput local_search_row_weighting_portfolio(
+        const Instance& instance,
+        std::mt19937_64& generator,
+        const LocalSearchRowWeightingPortfolioParameters& parameters = {});
+
 }
@@ -11,6 +11,14 @@ struct MilpParameters: Parameters
 {
     mathoptsolverscmake::SolverName solver = mathoptsolverscmake::SolverName::Highs;
 
+    /**
+     * Initial solution.
+     *
+     * It may be partial or infeasible. It is repaired and passed to the solver
+     * as a MIP start.
+     */
+    Solution* initial_solution = nullptr;
+
 
     virtual int format_width() const override { return 37; }
 
@@ -33,6 +41,22 @@ struct MilpParameters: Parameters
     }
 };
 
+/**
+ * Model built by an ILP algorithm, without solving it.
+ */
+struct MilpModel
+{
+    /** Model. */
+    mathoptsolverscmake::MathOptModel model;
+
+    /**
+     * MIP start built from the initial solution.
+     *
+     * Empty if it couldn't be built.
+     */
+    std::vector<double> milp_start;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////// Assignment-based ILP model //////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -68,6 +92,13 @@ Output milp_assignment(
         const Instance& instance,
         const MilpAssignmentParameters& parameters = {});
 
+/**
+ * Build the model and the MIP start of 'milp_assignment' without solving it.
+ */
+MilpModel milp_assignment_model(
+        const Instance& instance,
+        const MilpAssignmentParameters& parameters = {});
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////// Representatives ILP model ///////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -76,6 +107,14 @@ Output milp_representatives(
         const Instance& instance,
         const MilpParameters& parameters = {});
 
+/**
+ * Build the model and the MIP start of 'milp_representatives' without solving
+ * it.
+ */
+MilpModel milp_representatives_model(
+        const Instance& instance,
+        const MilpParameters& parameters = {});
+
 ////////////////////////////////////////////////////////////////////////////////
 /////////////////////// Partial-ordering based ILP model ///////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -111,4 +150,12 @@ Output milp_partial_ordering(
         const Instance& instance,
         const MilpPartialOrderingParameters& parameters = {});
 
+/**
+ * Build the model and the MIP start of 'milp_partial_ordering' without solving
+ * it.
+ */
+MilpModel milp_partial_ordering_model(
+        const Instance& instance,
+        const MilpPartialOrderingParameters& parameters = {});
+
 }
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "coloringsolver/solution.hpp"
+
+namespace coloringsolver
+{
+
+/**
+ * Change of the graph of an instance.
+ *
+ * Vertices are given by their ids in the file of the instance. The added
+ * vertices get the ids following the ones of the vertices of the graph
+ * before the change.
+ */
+struct GraphDelta
+{
+    /** Number of vertices added to the graph. */
+    VertexId number_of_added_vertices = 0;
+
+    /** Vertices removed from the graph, together with their edges. */
+    std::vector<VertexId> removed_vertices;
+
+    /** Edges added to the graph. */
+    std::vector<std::pair<VertexId, VertexId>> added_edges;
+
+    /** Edges removed from the graph. */
+    std::vector<std::pair<VertexId, VertexId>> removed_edges;
+};
+
+struct RecolorOutput: Output
+{
+    RecolorOutput(
+            const std::shared_ptr<const Instance>& instance):
+        Output(*instance),
+        instance(instance) { }
+
+
+    /** Instance of the changed graph. */
+    std::shared_ptr<const Instance> instance;
+
+    /**
+     * Id of each vertex in the changed graph.
+     *
+     * It is indexed by the vertex ids used in the delta and is '-1' for the
+     * removed vertices. The remaining vertices keep their relative order.
+     */
+    std::vector<VertexId> vertex_ids;
+
+    /** Number of vertices colored while repairing the solution. */
+    VertexId number_of_recolored_vertices = 0;
+
+    /** Number of Kempe chain interchanges. */
+    Counter number_of_kempe_chain_interchanges = 0;
+};
+
+struct RecolorParameters: Parameters
+{
+    /**
+     * Constructor.
+     *
+     * The clique lower bound is disabled by default since 'recolor' is
+     * called after each small change of the graph.
+     */
+    RecolorParameters() { clique_lower_bound = false; }
+
+    /**
+     * Maximum number of vertices of a Kempe chain.
+     *
+     * '0' disables Kempe chain interchanges.
+     */
+    VertexId maximum_kempe_chain_size = 1024;
+
+    /**
+     * Maximum number of iterations of the row weighting local search started
+     * from the repaired solution.
+     *
+     * '0' disables the local search.
+     */
+    Counter local_search_maximum_number_of_iterations = 0;
+};
+
+/**
+ * Apply a change to the graph of the instance of a solution and repair the
+ * solution.
+ *
+ * The colors of the vertices are kept. The vertices which are not colored
+ * after the change, that is, the added vertices and one end of each edge
+ * which has become conflicting, are colored again one by one, first with a
+ * color already used, then with a Kempe chain interchange freeing such a
+ * color, and otherwise with a new color.
+ *
+ * The changed graph and its instance are built from scratch, which takes
+ * O(n + m) time and memory whatever the size of the change; only the
+ * coloring is repaired incrementally. Calling it for each change of a stream
+ * of small changes is therefore only worth it on graphs which are cheap to
+ * rebuild compared to a full run of an algorithm.
+ */
+const RecolorOutput recolor(
+        const Solution& solution,
+        const GraphDelta& graph_delta,
+        std::mt19937_64& generator,
+        const RecolorParameters& parameters = {});
+
+}
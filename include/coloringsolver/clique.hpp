@@ -0,0 +1,35 @@
+#pragma once
+
+#include "coloringsolver/instance.hpp"
+
+#include "optimizationtools/utils/output.hpp"
+
+namespace coloringsolver
+{
+
+/**
+ * Find a large clique of the graph of an instance with a greedy algorithm.
+ *
+ * The size of the clique is a lower bound on the number of colors of any
+ * solution.
+ *
+ * A clique is grown from each vertex, among its neighbors which come after it
+ * in the degeneracy ordering of the instance, by adding the candidate which
+ * comes last in the ordering and removing the candidates which are not
+ * adjacent to it. The starting vertices are processed by non-increasing core
+ * number; a vertex can't belong to a clique larger than its core number plus
+ * one, so the search stops as soon as this is not larger than the best clique
+ * found.
+ *
+ * If 'number_of_threads' is greater than 1, the starting vertices are shared
+ * between several threads.
+ *
+ * If 'timer' is not 'nullptr', the search stops when it needs to end and the
+ * best clique found so far is returned.
+ */
+std::vector<VertexId> greedy_clique(
+        const Instance& instance,
+        Counter number_of_threads = 1,
+        const optimizationtools::Timer* timer = nullptr);
+
+}
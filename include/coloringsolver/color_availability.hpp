@@ -0,0 +1,123 @@
+#pragma once
+
+#include "coloringsolver/instance.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace coloringsolver
+{
+
+/**
+ * Scratch structure used to find a color which is not used by the neighbors
+ * of a vertex.
+ *
+ * Forbidden colors are stored in a bitmap packed in 64-bit words. The words
+ * which have been modified since the last reset are recorded, so that making
+ * all colors available again takes O(degree) instead of O(k). The first
+ * available color is found by scanning the words and taking the position of
+ * the lowest zero bit of the first word which is not full, that is, at most
+ * 'degree / 64 + 1' steps after the neighbors of a vertex have been
+ * forbidden.
+ */
+class ColorAvailability
+{
+
+public:
+
+    /** Constructor. */
+    ColorAvailability(ColorId number_of_colors):
+        number_of_colors_(number_of_colors),
+        words_((number_of_colors + 63) / 64 + 1, 0) { }
+
+    /** Get the number of colors. */
+    inline ColorId number_of_colors() const { return number_of_colors_; }
+
+    /** Make all colors available. */
+    inline void clear()
+    {
+        for (ColorId word_id: modified_words_)
+            words_[word_id] = 0;
+        modified_words_.clear();
+    }
+
+    /** Forbid a color. */
+    inline void forbid(ColorId color_id)
+    {
+        uint64_t& word = words_[color_id >> 6];
+        if (word == 0)
+            modified_words_.push_back(color_id >> 6);
+        word |= (uint64_t)1 << (color_id & 63);
+    }
+
+    /** Return 'true' iff a color is available. */
+    inline bool available(ColorId color_id) const
+    {
+        return ((words_[color_id >> 6] >> (color_id & 63)) & 1) == 0;
+    }
+
+    /**
+     * Get the smallest available color.
+     *
+     * Return 'number_of_colors()' if all colors are forbidden.
+     */
+    inline ColorId first_available() const
+    {
+        // The last word is never modified, so the scan always stops.
+        ColorId word_id = 0;
+        while (words_[word_id] == ~(uint64_t)0)
+            ++word_id;
+        ColorId color_id = 64 * word_id + lowest_zero_bit(words_[word_id]);
+        return std::min(color_id, number_of_colors_);
+    }
+
+    /**
+     * Get the first available color of a list of colors.
+     *
+     * Return '-1' if all colors of the list are forbidden.
+     */
+    template <typename Iterator>
+    inline ColorId first_available(
+            Iterator colors_begin,
+            Iterator colors_end) const
+    {
+        for (Iterator it = colors_begin; it != colors_end; ++it)
+            if (available(*it))
+                return *it;
+        return -1;
+    }
+
+private:
+
+    /** Get the position of the lowest zero bit of a word which is not full. */
+    static inline ColorId lowest_zero_bit(uint64_t word)
+    {
+#if defined(_MSC_VER)
+        unsigned long position;
+        _BitScanForward64(&position, ~word);
+        return position;
+#else
+        return __builtin_ctzll(~word);
+#endif
+    }
+
+    /** Number of colors. */
+    ColorId number_of_colors_;
+
+    /**
+     * Bitmap of the forbidden colors.
+     *
+     * It has one more word than needed, which stays empty.
+     */
+    std::vector<uint64_t> words_;
+
+    /** Words which have been modified since the last call to 'clear'. */
+    std::vector<ColorId> modified_words_;
+
+};
+
+}
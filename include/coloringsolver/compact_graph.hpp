@@ -0,0 +1,139 @@
+#pragma once
+
+#include "optimizationtools/graph/adjacency_list_graph.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace coloringsolver
+{
+
+using CompactVertexId = uint32_t;
+using CompactEdgeId = uint32_t;
+
+/**
+ * Immutable graph in compressed sparse row format.
+ *
+ * The neighbors of all the vertices are stored in a single array of 32-bit
+ * integers, together with the ids of the corresponding edges. It is built
+ * once by the instance and used in the hot loops of the algorithms instead of
+ * the virtual iterators of 'optimizationtools::AbstractGraph'.
+ *
+ * The arrays are either owned by the graph or stored in an external buffer,
+ * for example a memory-mapped binary cache file, in which case they are not
+ * copied.
+ *
+ * Owned arrays take '8 (n + 1) + 16 m' bytes on top of the adjacency list
+ * graph, that is, about a quarter of what the adjacency list graph itself
+ * takes with its 64-bit ids. The graph is built with the instance rather
+ * than on demand since the core decomposition of the instance and
+ * 'Solution::set' use it, so that nearly every algorithm needs it.
+ *
+ * Its methods have the same names as the ones of
+ * 'optimizationtools::AbstractGraph', so that templated algorithms can be
+ * instantiated with either of them.
+ */
+class CompactGraph
+{
+
+public:
+
+    /**
+     * Return 'true' iff a graph can be stored with 32-bit vertex and edge
+     * ids.
+     */
+    static bool fits(const optimizationtools::AdjacencyListGraph& graph);
+
+    /** Constructor. */
+    CompactGraph(const optimizationtools::AdjacencyListGraph& graph);
+
+    /**
+     * Create a graph from arrays stored in an external buffer.
+     *
+     * 'buffer' is kept alive as long as the graph.
+     */
+    CompactGraph(
+            optimizationtools::VertexId number_of_vertices,
+            optimizationtools::EdgeId number_of_edges,
+            optimizationtools::VertexId highest_degree,
+            const optimizationtools::EdgeId* offsets,
+            const CompactVertexId* neighbors,
+            const CompactEdgeId* edge_ids,
+            const std::shared_ptr<const void>& buffer);
+
+    /** The arrays may point to the owned vectors, so copies are forbidden. */
+    CompactGraph(const CompactGraph&) = delete;
+    CompactGraph& operator=(const CompactGraph&) = delete;
+
+    /** Get the number of vertices. */
+    inline optimizationtools::VertexId number_of_vertices() const { return number_of_vertices_; }
+
+    /** Get the number of edges. */
+    inline optimizationtools::EdgeId number_of_edges() const { return number_of_edges_; }
+
+    /** Get the degree of a vertex. */
+    inline optimizationtools::VertexId degree(optimizationtools::VertexId vertex_id) const { return offsets_[vertex_id + 1] - offsets_[vertex_id]; }
+
+    /** Get the highest degree of the graph. */
+    inline optimizationtools::VertexId highest_degree() const { return highest_degree_; }
+
+    /** Get a begin iterator to the neighbors of a vertex. */
+    inline const CompactVertexId* neighbors_begin(optimizationtools::VertexId vertex_id) const { return neighbors_ + offsets_[vertex_id]; }
+
+    /** Get an end iterator to the neighbors of a vertex. */
+    inline const CompactVertexId* neighbors_end(optimizationtools::VertexId vertex_id) const { return neighbors_ + offsets_[vertex_id + 1]; }
+
+    /**
+     * Get a begin iterator to the edges of a vertex.
+     *
+     * The edge at position 'i' links the vertex to its neighbor at position
+     * 'i'.
+     */
+    inline const CompactEdgeId* edges_begin(optimizationtools::VertexId vertex_id) const { return edge_ids_ + offsets_[vertex_id]; }
+
+    /** Get the array of the positions of the first neighbor of each vertex. */
+    inline const optimizationtools::EdgeId* offsets() const { return offsets_; }
+
+    /** Get the array of the neighbors of all the vertices. */
+    inline const CompactVertexId* neighbors() const { return neighbors_; }
+
+    /** Get the array of the edges of all the vertices. */
+    inline const CompactEdgeId* edge_ids() const { return edge_ids_; }
+
+private:
+
+    /** Number of vertices. */
+    optimizationtools::VertexId number_of_vertices_ = 0;
+
+    /** Number of edges. */
+    optimizationtools::EdgeId number_of_edges_ = 0;
+
+    /** Highest degree. */
+    optimizationtools::VertexId highest_degree_ = 0;
+
+    /** Position of the first neighbor of each vertex in 'neighbors_'. */
+    const optimizationtools::EdgeId* offsets_ = nullptr;
+
+    /** Neighbors of all the vertices. */
+    const CompactVertexId* neighbors_ = nullptr;
+
+    /** Edge linking each vertex to each of its neighbors. */
+    const CompactEdgeId* edge_ids_ = nullptr;
+
+    /*
+     * Storage of the arrays when they are owned by the graph.
+     */
+
+    std::vector<optimizationtools::EdgeId> offsets_storage_;
+
+    std::vector<CompactVertexId> neighbors_storage_;
+
+    std::vector<CompactEdgeId> edge_ids_storage_;
+
+    /** External buffer storing the arrays. */
+    std::shared_ptr<const void> buffer_ = nullptr;
+
+};
+
+}
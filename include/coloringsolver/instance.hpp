@@ -3,7 +3,11 @@
 #include "optimizationtools/graph/abstract_graph.hpp"
 #include "optimizationtools/graph/adjacency_list_graph.hpp"
 
+#include "coloringsolver/compact_graph.hpp"
+
 #include <memory>
+#include <mutex>
+#include <iostream>
 
 namespace coloringsolver
 {
@@ -11,12 +15,105 @@ namespace coloringsolver
 using VertexId = optimizationtools::VertexId;
 using VertexPos = optimizationtools::VertexPos;
 using EdgeId = optimizationtools::EdgeId;
+using EdgePos = optimizationtools::EdgeId;
 using ColorId = int64_t; // c
 using ColorPos = int64_t; // c_pos
-using Penalty = int16_t; // p
+using Penalty = int32_t; // p
+using PenaltySum = int64_t;
 using Counter = int64_t;
 using Seed = int64_t;
 
+/**
+ * Relabeling of the vertices applied when reading an instance.
+ *
+ * The vertices are renumbered so that neighbors get close ids, which makes the
+ * neighbor scans of the algorithms more cache friendly. Solutions are written
+ * with the original vertex ids.
+ */
+enum class VertexRelabeling {
+    None,
+    ReverseCuthillMcKee,
+    DegreeDescending,
+    BreadthFirstSearch,
+};
+
+std::istream& operator>>(std::istream& in, VertexRelabeling& vertex_relabeling);
+std::ostream& operator<<(std::ostream &os, VertexRelabeling vertex_relabeling);
+
+/**
+ * Parameters used when reading an instance from a file.
+ */
+struct InstanceReadParameters
+{
+    /** Relabeling of the vertices. */
+    VertexRelabeling vertex_relabeling = VertexRelabeling::None;
+
+    /** Remove the edges which appear several times in the file. */
+    bool remove_duplicate_edges = false;
+
+    /**
+     * Number of threads used to parse the file.
+     *
+     * If it is greater than 1, the 'snap', 'matrixmarket' and 'dimacs' formats
+     * are parsed by chunks of lines on several threads.
+     */
+    Counter number_of_threads = 1;
+};
+
+/**
+ * Adjacency list graph of a binary graph file, built the first time it is
+ * needed.
+ *
+ * It is built from the edge ends and the vertex weights of the mapped file,
+ * in O(n + m). It is shared by the copies of an instance and can be requested
+ * by several threads at the same time.
+ */
+class BinaryAdjacencyListGraph
+{
+
+public:
+
+    /** Constructor. */
+    BinaryAdjacencyListGraph(
+            VertexId number_of_vertices,
+            EdgeId number_of_edges,
+            const CompactVertexId* edge_ends,
+            const double* weights,
+            const std::shared_ptr<const void>& buffer):
+        number_of_vertices_(number_of_vertices),
+        number_of_edges_(number_of_edges),
+        edge_ends_(edge_ends),
+        weights_(weights),
+        buffer_(buffer) { }
+
+    /** Get the graph, building it if it hasn't been built yet. */
+    const optimizationtools::AdjacencyListGraph& graph() const;
+
+private:
+
+    /** Number of vertices. */
+    VertexId number_of_vertices_;
+
+    /** Number of edges. */
+    EdgeId number_of_edges_;
+
+    /** Ends of the edges in the mapped file. */
+    const CompactVertexId* edge_ends_;
+
+    /** Weights of the vertices in the mapped file. */
+    const double* weights_;
+
+    /** Mapped file. */
+    std::shared_ptr<const void> buffer_;
+
+    /** Flag ensuring that the graph is only built once. */
+    mutable std::once_flag once_flag_;
+
+    /** Graph. */
+    mutable std::unique_ptr<const optimizationtools::AdjacencyListGraph> graph_;
+
+};
+
 /**
  * Instance class for a graph coloring problem.
  */
@@ -32,20 +129,63 @@ public:
     /** Create an instance from an AbstrctGraph. */
     Instance(const std::shared_ptr<const optimizationtools::AbstractGraph>& abstract_graph);
 
-    /** Create an instance from a file. */
+    /**
+     * Create an instance from a file.
+     *
+     * The 'binary' format is the one written by 'write_binary'. The file is
+     * mapped in memory and the compact graph uses it without copy, after
+     * checking that all the ids it contains are valid. The adjacency list
+     * graph is only built from the edges of the file, in O(n + m), the first
+     * time 'graph()' or 'adjacency_list_graph()' is called.
+     *
+     * The read parameters are ignored for the 'cliquegraph' format.
+     */
     Instance(
             const std::string& instance_path,
-            const std::string& format);
+            const std::string& format,
+            const InstanceReadParameters& read_parameters = InstanceReadParameters());
 
     /*
      * Getters
      */
 
     /** Get graph. */
-    inline const optimizationtools::AbstractGraph& graph() const { return *graph_; }
+    inline const optimizationtools::AbstractGraph& graph() const { return (binary_graph_ != nullptr)? binary_graph_->graph(): *graph_; }
 
     /** Get the adjacency list graph. */
-    inline const optimizationtools::AdjacencyListGraph* adjacency_list_graph() const { return adjacency_list_graph_; }
+    inline const optimizationtools::AdjacencyListGraph* adjacency_list_graph() const { return (binary_graph_ != nullptr)? &binary_graph_->graph(): adjacency_list_graph_; }
+
+    /*
+     * The following getters use the compact graph when there is one, so that
+     * they don't build the adjacency list graph of a binary file.
+     */
+
+    /** Get the number of vertices. */
+    inline VertexId number_of_vertices() const { return (compact_graph_ != nullptr)? compact_graph_->number_of_vertices(): graph().number_of_vertices(); }
+
+    /** Get the number of edges. */
+    inline EdgeId number_of_edges() const { return (compact_graph_ != nullptr)? compact_graph_->number_of_edges(): graph().number_of_edges(); }
+
+    /** Get the highest degree. */
+    inline VertexId highest_degree() const { return (compact_graph_ != nullptr)? compact_graph_->highest_degree(): graph().highest_degree(); }
+
+    /**
+     * Get the compact graph.
+     *
+     * 'nullptr' if the graph is not an AdjacencyListGraph or if it is too
+     * large for 32-bit vertex and edge ids. Otherwise, it is always built,
+     * see 'CompactGraph' for its memory cost.
+     */
+    inline const CompactGraph* compact_graph() const { return compact_graph_.get(); }
+
+    /** Return 'true' iff the vertices have been relabeled. */
+    inline bool relabeled() const { return !original_vertex_ids_.empty(); }
+
+    /** Get the id of a vertex in the file the instance has been read from. */
+    inline VertexId original_vertex_id(VertexId vertex_id) const { return (relabeled())? original_vertex_ids_[vertex_id]: vertex_id; }
+
+    /** Get the id of a vertex from its id in the file. */
+    inline VertexId vertex_id(VertexId original_vertex_id) const { return (relabeled())? vertex_ids_[original_vertex_id]: original_vertex_id; }
 
     /**
      * Compute the core of the instance when looking for a coloration using 'k'
@@ -57,6 +197,38 @@ public:
      */
     std::vector<VertexId> compute_core(ColorId k) const;
 
+    /**
+     * Get a degeneracy ordering of the vertices.
+     *
+     * Vertices are sorted by non-decreasing core number, in the order in which
+     * they are peeled off the graph. When a vertex is removed, it has at most
+     * 'core_number(vertex_id)' neighbors after it in the ordering.
+     */
+    inline const std::vector<VertexId>& degeneracy_ordering() const { return degeneracy_ordering_; }
+
+    /** Get the core number of a vertex. */
+    inline VertexPos core_number(VertexId vertex_id) const { return core_numbers_[vertex_id]; }
+
+    /** Get the degeneracy of the graph, that is, its highest core number. */
+    inline VertexPos degeneracy() const { return (VertexPos)number_of_vertices_by_core_.size() - 2; }
+
+    /**
+     * Get the number of vertices removed from the graph when computing its
+     * core for a k-coloration.
+     *
+     * The removed vertices are the 'number_of_core_removed_vertices(k)' first
+     * vertices of 'degeneracy_ordering()'. They can be colored in the reverse
+     * order once the other vertices have been colored with 'k' colors.
+     */
+    inline VertexPos number_of_core_removed_vertices(ColorId k) const
+    {
+        if (k <= 0)
+            return 0;
+        if (k >= (ColorId)number_of_vertices_by_core_.size())
+            return number_of_vertices();
+        return number_of_vertices_by_core_[k];
+    }
+
     /*
      * Export
      */
@@ -66,15 +238,75 @@ public:
             std::ostream& os,
             int verbosity_level = 1) const;
 
+    /**
+     * Write the graph in binary format.
+     *
+     * The file can then be read much faster than the text formats with the
+     * 'binary' format. The weights of the vertices are written as well. If
+     * the vertices have been relabeled, the relabeled graph is written
+     * together with the original vertex ids.
+     */
+    void write_binary(const std::string& instance_path) const;
+
 private:
 
+    /*
+     * Private methods
+     */
+
+    /** Build the compact graph and compute the core decomposition. */
+    void initialize();
+
+    /** Renumber the vertices of the adjacency list graph. */
+    void relabel(VertexRelabeling vertex_relabeling);
+
+    /** Read a graph written by 'write_binary'. */
+    void read_binary(const std::string& instance_path);
+
+    /**
+     * Read an edge list in 'snap', 'matrixmarket' or 'dimacs' format on
+     * several threads.
+     */
+    void read_parallel(
+            const std::string& instance_path,
+            const std::string& format,
+            const InstanceReadParameters& read_parameters);
+
+    /**
+     * Build the adjacency list graph from edge lists.
+     *
+     * 'edges' contains one list per thread, each one storing the ends of its
+     * edges one after the other.
+     */
+    void build(
+            VertexId number_of_vertices,
+            const std::vector<std::vector<VertexId>>& edges,
+            bool remove_duplicate_edges);
+
+    /**
+     * Compute the core decomposition of the graph.
+     *
+     * This is the O(n + m) bucket algorithm from "An O(m) Algorithm for Cores
+     * Decomposition of Networks" (Batagelj and Zaversnik, 2003).
+     */
+    template <typename Graph>
+    void compute_core_decomposition(const Graph& graph);
+
     /*
      * Private attributes
      */
 
-    /** Graph. */
+    /**
+     * Graph.
+     *
+     * 'nullptr' if the instance has been read from a binary file and has not
+     * been relabeled. 'binary_graph_' is used instead.
+     */
     std::shared_ptr<const optimizationtools::AbstractGraph> graph_ = nullptr;
 
+    /** Adjacency list graph of the binary file the instance has been read from. */
+    std::shared_ptr<const BinaryAdjacencyListGraph> binary_graph_ = nullptr;
+
     /**
      * Adjacency list graph.
      *
@@ -82,6 +314,37 @@ private:
      */
     const optimizationtools::AdjacencyListGraph* adjacency_list_graph_ = nullptr;
 
+    /**
+     * Compact graph.
+     *
+     * It is built in 'initialize()' unless it has been read from a binary
+     * file.
+     */
+    std::shared_ptr<const CompactGraph> compact_graph_ = nullptr;
+
+    /**
+     * original_vertex_ids_[vertex_id] is the id in the file of vertex
+     * 'vertex_id'.
+     *
+     * Empty if the vertices have not been relabeled.
+     */
+    std::vector<VertexId> original_vertex_ids_;
+
+    /** Inverse permutation of 'original_vertex_ids_'. */
+    std::vector<VertexId> vertex_ids_;
+
+    /** Degeneracy ordering of the vertices. */
+    std::vector<VertexId> degeneracy_ordering_;
+
+    /** Core number of each vertex. */
+    std::vector<VertexPos> core_numbers_;
+
+    /**
+     * number_of_vertices_by_core_[c] is the number of vertices with a core
+     * number strictly smaller than 'c'.
+     */
+    std::vector<VertexPos> number_of_vertices_by_core_;
+
 };
 
 }
@@ -4,10 +4,10 @@
 
 #include "optimizationtools/utils/output.hpp"
 #include "optimizationtools/utils/utils.hpp"
+#include "optimizationtools/containers/indexed_set.hpp"
 #include "optimizationtools/containers/indexed_map.hpp"
 #include "optimizationtools/containers/doubly_indexed_map.hpp"
 
-#include <unordered_set>
 #include <iomanip>
 
 namespace coloringsolver
@@ -41,7 +41,7 @@ public:
     const Instance& instance() const { return *instance_; }
 
     /** Return 'true' iff the solution is feasible. */
-    bool feasible() const { return number_of_vertices() == instance().graph().number_of_vertices() && number_of_conflicts() == 0; };
+    bool feasible() const { return number_of_vertices() == instance().number_of_vertices() && number_of_conflicts() == 0; };
 
     /** Get the number of colors used in the solution. */
     ColorId number_of_colors() const { return map_.number_of_values(); }
@@ -70,8 +70,16 @@ public:
     /** Get an end iterator to the colors. */
     std::vector<ColorId>::const_iterator colors_end() const { return map_.values_end(); }
 
-    /** Get the set of conflicting edges. */
-    const std::unordered_set<EdgeId>& conflicts() const { return conflicts_; }
+    /**
+     * Get the set of conflicting edges.
+     *
+     * Conflicting edges are only tracked if the graph of the instance is an
+     * AdjacencyListGraph.
+     */
+    const optimizationtools::IndexedSet& conflicts() const { return conflicts_; }
+
+    /** Get the conflicting edge at position 'edge_pos' in 'conflicts()'. */
+    EdgeId conflict(EdgePos edge_pos) const { return *(conflicts_.begin() + edge_pos); }
 
     /** Get the set of conflicting vertices. */
     const optimizationtools::IndexedMap<VertexPos>& conflicting_vertices() const { return number_of_conflicts_; }
@@ -119,8 +127,13 @@ private:
     /** Map storing the color assigned to each vertex. */
     optimizationtools::DoublyIndexedMap map_;
 
-    /** Set of conflicting edges. */
-    std::unordered_set<EdgeId> conflicts_;
+    /**
+     * Set of conflicting edges.
+     *
+     * An indexed set is used so that insertions, deletions and uniform
+     * sampling of a conflicting edge are all performed in constant time.
+     */
+    optimizationtools::IndexedSet conflicts_;
 
     /** Conflicting vertices. */
     optimizationtools::IndexedMap<VertexPos> number_of_conflicts_;
@@ -135,11 +148,14 @@ void Solution::set(
         ColorId color_id,
         bool check)
 {
-    const optimizationtools::AbstractGraph& graph = instance().graph();
-
     // Checks.
-    graph.check_vertex_index(vertex_id);
-    if (color_id < -1 || color_id >= graph.number_of_vertices()) {
+    if (vertex_id < 0 || vertex_id >= instance().number_of_vertices()) {
+        throw std::out_of_range(
+                "Invalid vertex index: \"" + std::to_string(vertex_id) + "\"."
+                + " Vertex indices should belong to [0, "
+                + std::to_string(instance().number_of_vertices() - 1) + "].");
+    }
+    if (color_id < -1 || color_id >= instance().number_of_vertices()) {
         throw std::out_of_range(
                 "Invalid color value: \"" + std::to_string(color_id) + "\"."
                 + " Color values should belong to [-1, "
@@ -148,13 +164,46 @@ void Solution::set(
 
     // Update conflicts_.
     if (check) {
-        if (instance().adjacency_list_graph() != nullptr) {
+        if (instance().compact_graph() != nullptr) {
+            const CompactGraph& compact_graph = *instance().compact_graph();
+            const CompactVertexId* neighbors = compact_graph.neighbors_begin(vertex_id);
+            const CompactEdgeId* edges = compact_graph.edges_begin(vertex_id);
+            VertexId degree = compact_graph.degree(vertex_id);
+            for (VertexPos neighbor_pos = 0; neighbor_pos < degree; ++neighbor_pos) {
+                VertexId vertex_id_neighbor = neighbors[neighbor_pos];
+                EdgeId edge_id = edges[neighbor_pos];
+                // Remove old conflicts.
+                if (contains(vertex_id_neighbor)
+                        && color(vertex_id_neighbor) == color(vertex_id)) {
+                    total_number_of_conflicts_--;
+                    conflicts_.remove(edge_id);
+                    number_of_conflicts_.set(
+                            vertex_id,
+                            number_of_conflicts_[vertex_id] - 1);
+                    number_of_conflicts_.set(
+                            vertex_id_neighbor,
+                            number_of_conflicts_[vertex_id_neighbor] - 1);
+                }
+                // Add new conflicts.
+                if (color_id != -1
+                        && color(vertex_id_neighbor) == color_id) {
+                    total_number_of_conflicts_++;
+                    conflicts_.add(edge_id);
+                    number_of_conflicts_.set(
+                            vertex_id,
+                            number_of_conflicts_[vertex_id] + 1);
+                    number_of_conflicts_.set(
+                            vertex_id_neighbor,
+                            number_of_conflicts_[vertex_id_neighbor] + 1);
+                }
+            }
+        } else if (instance().adjacency_list_graph() != nullptr) {
             for (const auto& edge: instance().adjacency_list_graph()->edges(vertex_id)) {
                 // Remove old conflicts.
                 if (contains(edge.vertex_id)
                         && color(edge.vertex_id) == color(vertex_id)) {
                     total_number_of_conflicts_--;
-                    conflicts_.erase(edge.edge_id);
+                    conflicts_.remove(edge.edge_id);
                     number_of_conflicts_.set(
                             vertex_id,
                             number_of_conflicts_[vertex_id] - 1);
@@ -166,7 +215,7 @@ void Solution::set(
                 if (color_id != -1
                         && color(edge.vertex_id) == color_id) {
                     total_number_of_conflicts_++;
-                    conflicts_.insert(edge.edge_id);
+                    conflicts_.add(edge.edge_id);
                     number_of_conflicts_.set(
                             vertex_id,
                             number_of_conflicts_[vertex_id] + 1);
@@ -176,6 +225,7 @@ void Solution::set(
                 }
             }
         } else {
+            const optimizationtools::AbstractGraph& graph = instance().graph();
             auto it = graph.neighbors_begin(vertex_id);
             auto it_end = graph.neighbors_end(vertex_id);
             for (; it != it_end; ++it) {
@@ -304,11 +354,27 @@ struct Parameters: optimizationtools::Parameters
     /** Callback function called when a new best solution is found. */
     NewSolutionCallback new_solution_callback = [](const Output&, const std::string&) { };
 
+    /**
+     * Compute a clique lower bound at the start of the algorithm.
+     *
+     * The algorithms stop as soon as they find a solution with as many colors
+     * as the bound.
+     *
+     * It is disabled by default for the greedy algorithms and 'recolor'.
+     */
+    bool clique_lower_bound = true;
+
+    /** Number of threads used to compute the clique lower bound. */
+    Counter clique_lower_bound_number_of_threads = 1;
+
 
     virtual nlohmann::json to_json() const override
     {
         nlohmann::json json = optimizationtools::Parameters::to_json();
-        json.merge_patch({});
+        json.merge_patch({
+                {"CliqueLowerBound", clique_lower_bound},
+                {"CliqueLowerBoundNumberOfThreads", clique_lower_bound_number_of_threads},
+                });
         return json;
     }
 
@@ -317,9 +383,10 @@ struct Parameters: optimizationtools::Parameters
     virtual void format(std::ostream& os) const override
     {
         optimizationtools::Parameters::format(os);
-        //int width = format_width();
-        //os
-        //    ;
+        int width = format_width();
+        os
+            << std::setw(width) << std::left << "Clique lower bound: " << clique_lower_bound << std::endl
+            ;
     }
 };
 
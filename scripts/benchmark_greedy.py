@@ -0,0 +1,133 @@
+import argparse
+import sys
+import os
+import json
+
+
+# Compare the running times of the greedy algorithms of two builds of
+# coloringsolver, for example before and after a change of the color
+# selection:
+#
+#   python3 scripts/benchmark_greedy.py reference/bin/coloringsolver install/bin/coloringsolver
+#
+# The bundled test instances are always used. The gebremedhin2013 instances
+# are used if the COLORING_DATA environment variable is set. The script stops
+# if a run returns an infeasible solution.
+
+parser = argparse.ArgumentParser(description='')
+parser.add_argument(
+        "reference",
+        type=str,
+        help='reference coloringsolver executable')
+parser.add_argument(
+        "candidate",
+        type=str,
+        help='candidate coloringsolver executable')
+parser.add_argument(
+        "-r", "--repeat",
+        type=int,
+        default=3,
+        help='number of runs of each algorithm on each instance')
+parser.add_argument(
+        "-a", "--algorithms",
+        type=str,
+        nargs='*',
+        default=[
+            "greedy --ordering largest-first",
+            "greedy --ordering smallest-last --reverse 1",
+            "greedy --ordering dynamic-largest-first",
+            "greedy-dsatur"],
+        help='algorithms to benchmark')
+
+args = parser.parse_args()
+
+
+test_data = []
+with open(os.path.join("data", "test_all.txt"), 'r') as instances_file:
+    for line in instances_file:
+        test_data.append((os.path.join("data", line.strip()), "snap"))
+
+gebremedhin2013_data = []
+if "COLORING_DATA" in os.environ:
+    data_dir = os.environ["COLORING_DATA"]
+    for instance in [
+            "msdoor.mtx",
+            "ldoor.mtx",
+            "shipsec1.mtx",
+            "shipsec5.mtx",
+            "pkustk11.mtx",
+            "ct20stif.mtx",
+            "pwtk.mtx",
+            "pkustk13.mtx",
+            "nasasrb.mtx",
+            "bmw3_2.mtx"]:
+        gebremedhin2013_data.append((
+            os.path.join(data_dir, "gebremedhin2013", instance),
+            "matrixmarket"))
+
+
+def run(main, algorithm, instance_path, instance_format):
+    """Return the smallest running time and the value over the runs."""
+    json_output_path = "benchmark_output.json"
+    time_best = None
+    value = None
+    for _ in range(args.repeat):
+        command = (
+                main
+                + "  --verbosity-level 0"
+                + "  --input \"" + instance_path + "\""
+                + "  --format \"" + instance_format + "\""
+                + "  --algorithm " + algorithm
+                + "  --output \"" + json_output_path + "\"")
+        status = os.system(command)
+        if status != 0:
+            print(command)
+            sys.exit(1)
+        with open(json_output_path, 'r') as json_output_file:
+            output = json.load(json_output_file)["Output"]
+        if not output["Solution"]["Feasible"]:
+            print(command)
+            print("infeasible solution")
+            sys.exit(1)
+        if time_best is None or output["Time"] < time_best:
+            time_best = output["Time"]
+        value = output["Value"]
+    os.remove(json_output_path)
+    return time_best, value
+
+
+for dataset, data in [
+        ("tests", test_data),
+        ("gebremedhin2013", gebremedhin2013_data)]:
+    if not data:
+        continue
+    print(dataset)
+    print("-" * len(dataset))
+    print()
+    print(f"{'Algorithm':>48}"
+          f"{'Reference (s)':>16}"
+          f"{'Candidate (s)':>16}"
+          f"{'Speedup':>10}"
+          f"{'Same values':>14}")
+    for algorithm in args.algorithms:
+        time_reference = 0
+        time_candidate = 0
+        same_values = True
+        for instance_path, instance_format in data:
+            t_reference, v_reference = run(
+                    args.reference, algorithm, instance_path, instance_format)
+            t_candidate, v_candidate = run(
+                    args.candidate, algorithm, instance_path, instance_format)
+            time_reference += t_reference
+            time_candidate += t_candidate
+            if v_reference != v_candidate:
+                same_values = False
+        speedup = (
+                time_reference / time_candidate
+                if time_candidate > 0 else float('inf'))
+        print(f"{algorithm:>48}"
+              f"{time_reference:>16.3f}"
+              f"{time_candidate:>16.3f}"
+              f"{speedup:>10.2f}"
+              f"{str(same_values):>14}")
+    print()
@@ -1,5 +1,7 @@
 #include "coloringsolver/algorithm_formatter.hpp"
 
+#include "coloringsolver/clique.hpp"
+
 #include "optimizationtools/utils/utils.hpp"
 
 #include <iomanip>
@@ -105,6 +107,23 @@ void AlgorithmFormatter::update_bound(
     }
 }
 
+void AlgorithmFormatter::update_clique_bound()
+{
+    if (!parameters_.clique_lower_bound)
+        return;
+    std::vector<VertexId> clique = greedy_clique(
+            output_.solution.instance(),
+            parameters_.clique_lower_bound_number_of_threads,
+            &parameters_.timer);
+    update_bound(clique.size(), "clique");
+}
+
+bool AlgorithmFormatter::optimal() const
+{
+    return output_.solution.feasible()
+        && output_.solution.number_of_colors() <= output_.bound;
+}
+
 void AlgorithmFormatter::end()
 {
     output_.time = parameters_.timer.elapsed_time();
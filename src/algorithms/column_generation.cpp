@@ -1,6 +1,7 @@
 #include "coloringsolver/algorithms/column_generation.hpp"
 
 #include "coloringsolver/algorithm_formatter.hpp"
+#include "coloringsolver/algorithms/greedy.hpp"
 
 #include "columngenerationsolver/algorithms/column_generation.hpp"
 #include "columngenerationsolver/algorithms/greedy.hpp"
@@ -10,6 +11,8 @@
 #include "stablesolver/stable/instance_builder.hpp"
 #include "stablesolver/stable/algorithms/local_search.hpp"
 
+#include <numeric>
+
 /**
  * The linear programming formulation of the problem based on Dantzig–Wolfe
  * decomposition is written as follows:
@@ -34,6 +37,13 @@
  * Therefore, finding a variable of minium reduced cost reduces to solving
  * a Maximum-Weight Independent Set Problem with vertices with weight vᵥ.
  *
+ * The pricing problem is solved heuristically, so the reduced cost of the
+ * column found does not yield a valid bound. Instead, the vertices are
+ * partitioned into cliques and the sum over the cliques of their largest
+ * weight gives an upper bound θ on the weight of any stable set. Then
+ * (vᵥ / θ) is a feasible dual solution of the linear relaxation, and
+ * ∑ᵥ vᵥ / θ is a lower bound on its value (Farley bound).
+ *
  */
 
 using namespace coloringsolver;
@@ -48,10 +58,22 @@ class PricingSolver: public columngenerationsolver::PricingSolver
 
 public:
 
-    PricingSolver(const Instance& instance):
+    PricingSolver(
+            const Instance& instance,
+            const ColumnGenerationParameters& parameters,
+            AlgorithmFormatter& algorithm_formatter,
+            bool& end):
         instance_(instance),
+        maximum_number_of_columns_(parameters.maximum_number_of_columns_per_pricing),
+        algorithm_formatter_(algorithm_formatter),
+        end_(end),
         fixed_vertices_(instance.graph().number_of_vertices()),
-        coloring2mwis_(instance.graph().number_of_vertices())
+        coloring2mwis_(instance.graph().number_of_vertices(), -1),
+        mwis_neighbors_(instance.graph().number_of_vertices()),
+        mwis_neighbor_positions_(instance.graph().number_of_vertices()),
+        marks_(instance.graph().number_of_vertices(), -1),
+        clique_partition_assigned_(instance.graph().number_of_vertices()),
+        covered_(instance.graph().number_of_vertices())
     {  }
 
     virtual std::vector<std::shared_ptr<const Column>> initialize_pricing(
@@ -62,19 +84,122 @@ public:
 
 private:
 
+    /**
+     * Update the subgraph induced by the vertices which are not fixed and
+     * have a positive dual.
+     *
+     * The subgraph is kept from one call to the next, since the set of
+     * vertices with a positive dual usually changes little between two
+     * iterations. Only the vertices which enter or leave the subgraph are
+     * processed, unless most of them do, in which case the subgraph is built
+     * again.
+     */
+    void update_subgraph(const std::vector<Value>& duals);
+
+    /** Add a vertex at the end of the subgraph. */
+    void add_subgraph_vertex(VertexId vertex_id);
+
+    /**
+     * Remove a vertex from the subgraph.
+     *
+     * The last vertex of the subgraph takes its place.
+     */
+    void remove_subgraph_vertex(stablesolver::stable::VertexId mwis_vertex_id);
+
+    /**
+     * Compute an upper bound on the weight of the stable sets of the
+     * subgraph, weighted by the duals.
+     *
+     * The vertices are partitioned greedily into cliques, from the heaviest
+     * one. A stable set contains at most one vertex of each clique, and the
+     * first vertex of a clique is its heaviest one.
+     *
+     * The vertices of the subgraph sorted by non-increasing weight are left
+     * in 'sorted_vertices_'.
+     */
+    Value stable_weight_upper_bound(const std::vector<Value>& duals);
+
+    /**
+     * Add vertices to 'stable_set_' until it is maximal.
+     *
+     * The vertices are considered by non-increasing weight, starting with
+     * those which are not covered by the columns already found during the
+     * current pricing, so that the columns differ from each other.
+     */
+    void extend_stable_set();
+
+    /** Add 'stable_set_' to the columns of a pricing output. */
+    void add_column(
+            const std::vector<Value>& duals,
+            PricingOutput& output,
+            Value& reduced_cost);
+
     const Instance& instance_;
 
+    /** Maximum number of columns returned by a pricing. */
+    Counter maximum_number_of_columns_;
+
+    AlgorithmFormatter& algorithm_formatter_;
+
+    /** Set to 'true' once the solution is proven optimal. */
+    bool& end_;
+
+    /**
+     * 'true' iff no column is fixed, that is, iff the bounds computed from
+     * the duals are valid for the whole problem.
+     */
+    bool root_ = true;
+
     std::vector<int8_t> fixed_vertices_;
 
     std::vector<VertexId> mwis2coloring_;
 
     std::vector<stablesolver::stable::VertexId> coloring2mwis_;
 
+    /** Neighbors of the vertices of the subgraph. */
+    std::vector<std::vector<stablesolver::stable::VertexId>> mwis_neighbors_;
+
+    /**
+     * mwis_neighbor_positions_[v][k] is the position of 'v' in the neighbors
+     * of its k-th neighbor.
+     *
+     * It is used to remove the edges of a vertex from the subgraph in time
+     * linear in its degree.
+     */
+    std::vector<std::vector<VertexPos>> mwis_neighbor_positions_;
+
     std::vector<stablesolver::stable::Weight> weights_;
 
+    std::vector<VertexId> subgraph_added_vertices_;
+
+    std::vector<VertexId> subgraph_removed_vertices_;
+
+    std::vector<Counter> marks_;
+
+    Counter mark_ = 0;
+
+    std::vector<stablesolver::stable::VertexId> sorted_vertices_;
+
+    std::vector<int8_t> clique_partition_assigned_;
+
+    std::vector<stablesolver::stable::VertexId> clique_partition_candidates_;
+
+    /** Stable set of the subgraph being turned into a column. */
+    std::vector<stablesolver::stable::VertexId> stable_set_;
+
+    /**
+     * For each vertex of the subgraph, '1' iff it belongs to a column found
+     * during the current pricing.
+     */
+    std::vector<int8_t> covered_;
+
 };
 
-columngenerationsolver::Model get_model(const Instance& instance)
+columngenerationsolver::Model get_model(
+        const Instance& instance,
+        const ColumnGenerationParameters& parameters,
+        AlgorithmFormatter& algorithm_formatter,
+        bool& end)
 {
     columngenerationsolver::Model model;
 
@@ -93,7 +218,11 @@ columngenerationsolver::Model get_model(const Instance& instance)
 
     // Pricing solver.
     model.pricing_solver = std::unique_ptr<columngenerationsolver::PricingSolver>(
-            new PricingSolver(instance));
+            new PricingSolver(
+                instance,
+                parameters,
+                algorithm_formatter,
+                end));
 
     return model;
 }
@@ -118,10 +247,47 @@ Solution columns2solution(
     return solution;
 }
 
+/**
+ * Get the initial columns of the column generation.
+ *
+ * Each color of the repaired initial solution yields a column. If no initial
+ * solution is given, there is no initial column.
+ */
+std::vector<std::shared_ptr<const Column>> get_initial_columns(
+        const Instance& instance,
+        const ColumnGenerationParameters& parameters,
+        AlgorithmFormatter& algorithm_formatter)
+{
+    if (parameters.initial_solution == nullptr)
+        return {};
+    Parameters repair_parameters;
+    repair_parameters.verbosity_level = 0;
+    repair_parameters.clique_lower_bound = false;
+    Solution solution = greedy_repair(*parameters.initial_solution, repair_parameters).solution;
+    algorithm_formatter.update_solution(solution, "initial solution");
+
+    std::vector<Column> columns(solution.number_of_colors());
+    for (VertexId vertex_id = 0;
+            vertex_id < instance.graph().number_of_vertices();
+            ++vertex_id) {
+        columngenerationsolver::LinearTerm element;
+        element.row = vertex_id;
+        element.coefficient = 1;
+        columns[solution.color(vertex_id)].elements.push_back(element);
+    }
+    std::vector<std::shared_ptr<const Column>> initial_columns;
+    for (Column& column: columns) {
+        column.objective_coefficient = 1;
+        initial_columns.push_back(std::shared_ptr<const Column>(new Column(column)));
+    }
+    return initial_columns;
+}
+
 std::vector<std::shared_ptr<const Column>> PricingSolver::initialize_pricing(
             const std::vector<std::pair<std::shared_ptr<const Column>, Value>>& fixed_columns)
 {
     std::fill(fixed_vertices_.begin(), fixed_vertices_.end(), -1);
+    root_ = true;
     for (auto p: fixed_columns) {
         const Column& column = *(p.first);
         Value value = p.second;
@@ -131,11 +297,230 @@ std::vector<std::shared_ptr<const Column>> PricingSolver::initialize_pricing(
             if (element.coefficient < 0.5)
                 continue;
             fixed_vertices_[element.row] = 1;
+            root_ = false;
         }
     }
     return {};
 }
 
+void PricingSolver::add_subgraph_vertex(VertexId vertex_id)
+{
+    stablesolver::stable::VertexId mwis_vertex_id = mwis2coloring_.size();
+    coloring2mwis_[vertex_id] = mwis_vertex_id;
+    mwis2coloring_.push_back(vertex_id);
+    mark_++;
+    for (auto it = instance_.graph().neighbors_begin(vertex_id);
+            it != instance_.graph().neighbors_end(vertex_id);
+            ++it) {
+        stablesolver::stable::VertexId mwis_vertex_id_neighbor = coloring2mwis_[*it];
+        if (mwis_vertex_id_neighbor == -1
+                || mwis_vertex_id_neighbor == mwis_vertex_id)
+            continue;
+        // Skip duplicate edges.
+        if (marks_[mwis_vertex_id_neighbor] == mark_)
+            continue;
+        marks_[mwis_vertex_id_neighbor] = mark_;
+        VertexPos pos = mwis_neighbors_[mwis_vertex_id].size();
+        VertexPos pos_neighbor = mwis_neighbors_[mwis_vertex_id_neighbor].size();
+        mwis_neighbors_[mwis_vertex_id].push_back(mwis_vertex_id_neighbor);
+        mwis_neighbor_positions_[mwis_vertex_id].push_back(pos_neighbor);
+        mwis_neighbors_[mwis_vertex_id_neighbor].push_back(mwis_vertex_id);
+        mwis_neighbor_positions_[mwis_vertex_id_neighbor].push_back(pos);
+    }
+}
+
+void PricingSolver::remove_subgraph_vertex(
+        stablesolver::stable::VertexId mwis_vertex_id)
+{
+    // Remove the edges of the vertex.
+    // The last neighbor of each neighbor takes the place of the vertex in its
+    // neighbors.
+    for (VertexPos pos = 0;
+            pos < (VertexPos)mwis_neighbors_[mwis_vertex_id].size();
+            ++pos) {
+        stablesolver::stable::VertexId mwis_vertex_id_neighbor
+            = mwis_neighbors_[mwis_vertex_id][pos];
+        VertexPos pos_neighbor = mwis_neighbor_positions_[mwis_vertex_id][pos];
+        std::vector<stablesolver::stable::VertexId>& neighbors
+            = mwis_neighbors_[mwis_vertex_id_neighbor];
+        std::vector<VertexPos>& neighbor_positions
+            = mwis_neighbor_positions_[mwis_vertex_id_neighbor];
+        stablesolver::stable::VertexId mwis_vertex_id_moved = neighbors.back();
+        VertexPos pos_moved = neighbor_positions.back();
+        neighbors[pos_neighbor] = mwis_vertex_id_moved;
+        neighbor_positions[pos_neighbor] = pos_moved;
+        mwis_neighbor_positions_[mwis_vertex_id_moved][pos_moved] = pos_neighbor;
+        neighbors.pop_back();
+        neighbor_positions.pop_back();
+    }
+    mwis_neighbors_[mwis_vertex_id].clear();
+    mwis_neighbor_positions_[mwis_vertex_id].clear();
+    coloring2mwis_[mwis2coloring_[mwis_vertex_id]] = -1;
+
+    // Move the last vertex of the subgraph to the free position.
+    stablesolver::stable::VertexId mwis_vertex_id_last = mwis2coloring_.size() - 1;
+    if (mwis_vertex_id != mwis_vertex_id_last) {
+        for (VertexPos pos = 0;
+                pos < (VertexPos)mwis_neighbors_[mwis_vertex_id_last].size();
+                ++pos) {
+            stablesolver::stable::VertexId mwis_vertex_id_neighbor
+                = mwis_neighbors_[mwis_vertex_id_last][pos];
+            VertexPos pos_neighbor = mwis_neighbor_positions_[mwis_vertex_id_last][pos];
+            mwis_neighbors_[mwis_vertex_id_neighbor][pos_neighbor] = mwis_vertex_id;
+        }
+        mwis_neighbors_[mwis_vertex_id].swap(mwis_neighbors_[mwis_vertex_id_last]);
+        mwis_neighbor_positions_[mwis_vertex_id].swap(mwis_neighbor_positions_[mwis_vertex_id_last]);
+        mwis2coloring_[mwis_vertex_id] = mwis2coloring_[mwis_vertex_id_last];
+        coloring2mwis_[mwis2coloring_[mwis_vertex_id]] = mwis_vertex_id;
+    }
+    mwis2coloring_.pop_back();
+}
+
+void PricingSolver::update_subgraph(
+        const std::vector<Value>& duals)
+{
+    subgraph_removed_vertices_.clear();
+    subgraph_added_vertices_.clear();
+    for (VertexId vertex_id = 0;
+            vertex_id < instance_.graph().number_of_vertices();
+            ++vertex_id) {
+        bool in_subgraph = (fixed_vertices_[vertex_id] != 1 && duals[vertex_id] > 0);
+        if (in_subgraph && coloring2mwis_[vertex_id] == -1) {
+            subgraph_added_vertices_.push_back(vertex_id);
+        } else if (!in_subgraph && coloring2mwis_[vertex_id] != -1) {
+            subgraph_removed_vertices_.push_back(vertex_id);
+        }
+    }
+
+    if (2 * (subgraph_removed_vertices_.size() + subgraph_added_vertices_.size())
+            < mwis2coloring_.size()) {
+        for (VertexId vertex_id: subgraph_removed_vertices_)
+            remove_subgraph_vertex(coloring2mwis_[vertex_id]);
+        for (VertexId vertex_id: subgraph_added_vertices_)
+            add_subgraph_vertex(vertex_id);
+        return;
+    }
+
+    // Most of the subgraph changes, build it again.
+    for (stablesolver::stable::VertexId mwis_vertex_id = 0;
+            mwis_vertex_id < (stablesolver::stable::VertexId)mwis2coloring_.size();
+            ++mwis_vertex_id) {
+        mwis_neighbors_[mwis_vertex_id].clear();
+        mwis_neighbor_positions_[mwis_vertex_id].clear();
+        coloring2mwis_[mwis2coloring_[mwis_vertex_id]] = -1;
+    }
+    mwis2coloring_.clear();
+    for (VertexId vertex_id = 0;
+            vertex_id < instance_.graph().number_of_vertices();
+            ++vertex_id) {
+        if (fixed_vertices_[vertex_id] != 1 && duals[vertex_id] > 0)
+            add_subgraph_vertex(vertex_id);
+    }
+}
+
+Value PricingSolver::stable_weight_upper_bound(
+        const std::vector<Value>& duals)
+{
+    stablesolver::stable::VertexId number_of_vertices = mwis2coloring_.size();
+    sorted_vertices_.resize(number_of_vertices);
+    std::iota(
+            sorted_vertices_.begin(),
+            sorted_vertices_.end(),
+            0);
+    std::fill(
+            clique_partition_assigned_.begin(),
+            clique_partition_assigned_.begin() + number_of_vertices,
+            0);
+    auto heavier = [this, &duals](
+            stablesolver::stable::VertexId mwis_vertex_id_1,
+            stablesolver::stable::VertexId mwis_vertex_id_2)
+    {
+        return duals[mwis2coloring_[mwis_vertex_id_1]]
+            > duals[mwis2coloring_[mwis_vertex_id_2]];
+    };
+    std::sort(
+            sorted_vertices_.begin(),
+            sorted_vertices_.end(),
+            heavier);
+
+    Value upper_bound = 0;
+    for (stablesolver::stable::VertexId mwis_vertex_id: sorted_vertices_) {
+        if (clique_partition_assigned_[mwis_vertex_id])
+            continue;
+        upper_bound += duals[mwis2coloring_[mwis_vertex_id]];
+        clique_partition_assigned_[mwis_vertex_id] = 1;
+
+        clique_partition_candidates_.clear();
+        for (stablesolver::stable::VertexId mwis_vertex_id_neighbor: mwis_neighbors_[mwis_vertex_id])
+            if (!clique_partition_assigned_[mwis_vertex_id_neighbor])
+                clique_partition_candidates_.push_back(mwis_vertex_id_neighbor);
+        std::sort(
+                clique_partition_candidates_.begin(),
+                clique_partition_candidates_.end(),
+                heavier);
+
+        while (!clique_partition_candidates_.empty()) {
+            stablesolver::stable::VertexId mwis_vertex_id_added
+                = clique_partition_candidates_.front();
+            clique_partition_assigned_[mwis_vertex_id_added] = 1;
+            mark_++;
+            for (stablesolver::stable::VertexId mwis_vertex_id_neighbor: mwis_neighbors_[mwis_vertex_id_added])
+                marks_[mwis_vertex_id_neighbor] = mark_;
+            VertexPos number_of_candidates = 0;
+            for (stablesolver::stable::VertexId mwis_vertex_id_candidate: clique_partition_candidates_) {
+                if (marks_[mwis_vertex_id_candidate] == mark_) {
+                    clique_partition_candidates_[number_of_candidates]
+                        = mwis_vertex_id_candidate;
+                    number_of_candidates++;
+                }
+            }
+            clique_partition_candidates_.resize(number_of_candidates);
+        }
+    }
+    return upper_bound;
+}
+
+void PricingSolver::extend_stable_set()
+{
+    mark_++;
+    for (stablesolver::stable::VertexId mwis_vertex_id: stable_set_) {
+        marks_[mwis_vertex_id] = mark_;
+        for (stablesolver::stable::VertexId mwis_vertex_id_neighbor: mwis_neighbors_[mwis_vertex_id])
+            marks_[mwis_vertex_id_neighbor] = mark_;
+    }
+    for (int8_t covered = 0; covered <= 1; ++covered) {
+        for (stablesolver::stable::VertexId mwis_vertex_id: sorted_vertices_) {
+            if (covered_[mwis_vertex_id] != covered)
+                continue;
+            if (marks_[mwis_vertex_id] == mark_)
+                continue;
+            stable_set_.push_back(mwis_vertex_id);
+            marks_[mwis_vertex_id] = mark_;
+            for (stablesolver::stable::VertexId mwis_vertex_id_neighbor: mwis_neighbors_[mwis_vertex_id])
+                marks_[mwis_vertex_id_neighbor] = mark_;
+        }
+    }
+}
+
+void PricingSolver::add_column(
+        const std::vector<Value>& duals,
+        PricingOutput& output,
+        Value& reduced_cost)
+{
+    std::shared_ptr<Column> column = std::make_shared<Column>();
+    column->objective_coefficient = 1;
+    reduced_cost = 1;
+    for (stablesolver::stable::VertexId mwis_vertex_id: stable_set_) {
+        columngenerationsolver::LinearTerm element;
+        element.row = mwis2coloring_[mwis_vertex_id];
+        element.coefficient = 1;
+        column->elements.push_back(element);
+        reduced_cost -= duals[element.row];
+        covered_[mwis_vertex_id] = 1;
+    }
+    output.columns.push_back(column);
+}
+
 columngenerationsolver::PricingSolver::PricingOutput PricingSolver::solve_pricing(
             const std::vector<Value>& duals)
 {
@@ -144,34 +529,29 @@ columngenerationsolver::PricingSolver::PricingOutput PricingSolver::solve_pricin
 
     stablesolver::stable::Weight mult = 10000;
 
+    // Update subproblem instance.
+    update_subgraph(duals);
+    weights_.resize(mwis2coloring_.size());
+    for (stablesolver::stable::VertexId mwis_vertex_id = 0;
+            mwis_vertex_id < (stablesolver::stable::VertexId)mwis2coloring_.size();
+            ++mwis_vertex_id) {
+        VertexId vertex_id = mwis2coloring_[mwis_vertex_id];
+        weights_[mwis_vertex_id] = std::max(
+                (stablesolver::stable::Weight)1,
+                (stablesolver::stable::Weight)std::floor(mult * duals[vertex_id]));
+    }
+
     // Build subproblem instance.
-    std::fill(coloring2mwis_.begin(), coloring2mwis_.end(), -1);
-    mwis2coloring_.clear();
+    // 'stablesolver::stable::Instance' can't be modified once built,
+    // therefore, it is built again from the subgraph at each pricing.
     stablesolver::stable::InstanceBuilder mwis_instance_builder;
-    // Add vertices.
-    for (VertexId vertex_id = 0;
-            vertex_id < instance_.graph().number_of_vertices();
-            ++vertex_id) {
-        if (fixed_vertices_[vertex_id] == 1)
-            continue;
-        stablesolver::stable::Weight weight = std::floor(mult * duals[vertex_id]);
-        if (weight <= 0)
-            continue;
-        coloring2mwis_[vertex_id] = mwis2coloring_.size();
-        mwis2coloring_.push_back(vertex_id);
+    for (stablesolver::stable::Weight weight: weights_)
         mwis_instance_builder.add_vertex(weight);
-    }
-    // Add edges.
     for (stablesolver::stable::VertexId mwis_vertex_id_1 = 0;
             mwis_vertex_id_1 < (stablesolver::stable::VertexId)mwis2coloring_.size();
             ++mwis_vertex_id_1) {
-        VertexId vertex_id_1 = mwis2coloring_[mwis_vertex_id_1];
-        for (auto it = instance_.graph().neighbors_begin(vertex_id_1);
-                it != instance_.graph().neighbors_end(vertex_id_1); ++it) {
-            VertexId vertex_id_2 = *it;
-            stablesolver::stable::VertexId mwis_vertex_id_2 = coloring2mwis_[vertex_id_2];
-            if (mwis_vertex_id_2 != -1
-                    && mwis_vertex_id_2 > mwis_vertex_id_1) {
+        for (stablesolver::stable::VertexId mwis_vertex_id_2: mwis_neighbors_[mwis_vertex_id_1]) {
+            if (mwis_vertex_id_2 > mwis_vertex_id_1) {
                 mwis_instance_builder.add_edge(
                         mwis_vertex_id_1,
                         mwis_vertex_id_2);
@@ -188,22 +568,68 @@ columngenerationsolver::PricingSolver::PricingOutput PricingSolver::solve_pricin
             mwis_instance,
             mwis_parameters);
 
-    // Retrieve column.
-    Column column;
+    Value weight_upper_bound = stable_weight_upper_bound(duals);
+
+    // Retrieve columns.
+    // The first column is the stable set found by the local search, made
+    // maximal. The next ones start from the heaviest vertex which is not
+    // covered yet, as long as they have a negative reduced cost.
+    std::fill(
+            covered_.begin(),
+            covered_.begin() + mwis2coloring_.size(),
+            0);
+    stable_set_.clear();
     for (stablesolver::stable::VertexId mwis_vertex_id = 0;
             mwis_vertex_id < mwis_instance.number_of_vertices();
             ++mwis_vertex_id) {
-        if (output_mwis.solution.contains(mwis_vertex_id)) {
-            columngenerationsolver::LinearTerm element;
-            element.row = mwis2coloring_[mwis_vertex_id];
-            element.coefficient = 1;
-            column.elements.push_back(element);
+        if (output_mwis.solution.contains(mwis_vertex_id))
+            stable_set_.push_back(mwis_vertex_id);
+    }
+    extend_stable_set();
+    Value reduced_cost = 0;
+    add_column(duals, output, reduced_cost);
+    VertexPos seed_pos = 0;
+    while (reduced_cost < -1e-6
+            && (Counter)output.columns.size() < maximum_number_of_columns_) {
+        while (seed_pos < (VertexPos)sorted_vertices_.size()
+                && covered_[sorted_vertices_[seed_pos]]) {
+            seed_pos++;
         }
+        if (seed_pos == (VertexPos)sorted_vertices_.size())
+            break;
+        // The seed is not covered by the previous columns, so the new column
+        // is different from them.
+        stable_set_.clear();
+        stable_set_.push_back(sorted_vertices_[seed_pos]);
+        extend_stable_set();
+        add_column(duals, output, reduced_cost);
+        if (reduced_cost >= -1e-6)
+            output.columns.pop_back();
     }
-    column.objective_coefficient = 1;
 
-    output.columns.push_back(std::shared_ptr<const columngenerationsolver::Column>(new columngenerationsolver::Column(column)));
-    output.overcost = instance_.graph().highest_degree() * std::min(0.0, columngenerationsolver::compute_reduced_cost(*output.columns.front(), duals));
+    // The reduced costs of the columns found are not necessarily minimal, so
+    // the overcost is computed from a proven bound on the minimum reduced
+    // cost instead. An optimal solution has at most 'highest_degree + 1'
+    // colors.
+    output.overcost = (instance_.graph().highest_degree() + 1)
+        * std::min(0.0, 1 - weight_upper_bound);
+
+    if (root_ && weight_upper_bound > 0) {
+        Value farley_bound = 0;
+        for (VertexId vertex_id = 0;
+                vertex_id < instance_.graph().number_of_vertices();
+                ++vertex_id) {
+            farley_bound += duals[vertex_id];
+        }
+        farley_bound /= std::max(1.0, weight_upper_bound);
+        // The duals returned by the linear programming solver are only
+        // accurate up to its tolerance.
+        algorithm_formatter_.update_bound(
+                std::ceil(farley_bound - 1e-6),
+                "linear relaxation");
+        if (algorithm_formatter_.optimal())
+            end_ = true;
+    }
     return output;
 }
 
@@ -215,13 +641,29 @@ const Output coloringsolver::column_generation_heuristic_greedy(
     AlgorithmFormatter algorithm_formatter(parameters, output);
     algorithm_formatter.start("Column generation heuristic - Greedy");
     algorithm_formatter.print_header();
-
-    columngenerationsolver::Model model = get_model(instance);
+    algorithm_formatter.update_clique_bound();
+
+    // Stop as soon as the solution is optimal.
+    bool end = false;
+    columngenerationsolver::Model model = get_model(
+            instance,
+            parameters,
+            algorithm_formatter,
+            end);
     columngenerationsolver::GreedyParameters cgsg_parameters;
     cgsg_parameters.verbosity_level = 0;
     cgsg_parameters.timer = parameters.timer;
+    cgsg_parameters.timer.add_end_boolean(&end);
     cgsg_parameters.column_generation_parameters.solver_name
         = parameters.linear_programming_solver;
+    cgsg_parameters.initial_columns = get_initial_columns(
+            instance,
+            parameters,
+            algorithm_formatter);
+    if (algorithm_formatter.optimal()) {
+        algorithm_formatter.end();
+        return output;
+    }
     // Self-ajusting Wentges smoothing and automatic directional smoothing do
     // not work well on the Graph Coloring Problem as shown in "Automation and
     // Combination of Linear-Programming Based Stabilization Techniques in
@@ -233,9 +675,6 @@ const Output coloringsolver::column_generation_heuristic_greedy(
     cgsg_parameters.column_generation_parameters.automatic_directional_smoothing = false;
     auto output_greedy = columngenerationsolver::greedy(model, cgsg_parameters);
 
-    //algorithm_formatter.update_lower_bound(
-    //        std::ceil(output_greedy.bound - FFOT_TOL),
-    //        "");
     if (output_greedy.solution.feasible()) {
         algorithm_formatter.update_solution(
                 columns2solution(instance, output_greedy.solution.columns()),
@@ -254,15 +693,33 @@ const Output coloringsolver::column_generation_heuristic_limited_discrepancy_sea
     AlgorithmFormatter algorithm_formatter(parameters, output);
     algorithm_formatter.start("Column generation heuristic - Limited discrepancy search");
     algorithm_formatter.print_header();
-
-    columngenerationsolver::Model model = get_model(instance);
+    algorithm_formatter.update_clique_bound();
+
+    // Stop as soon as the solution is optimal, that is, as soon as its
+    // number of colors reaches the rounded up bound of the linear
+    // relaxation, instead of exploring more discrepancies.
+    bool end = false;
+    columngenerationsolver::Model model = get_model(
+            instance,
+            parameters,
+            algorithm_formatter,
+            end);
     columngenerationsolver::LimitedDiscrepancySearchParameters cgslds_parameters;
     cgslds_parameters.verbosity_level = 1;
     cgslds_parameters.timer = parameters.timer;
+    cgslds_parameters.timer.add_end_boolean(&end);
     cgslds_parameters.internal_diving = 1;
     cgslds_parameters.column_generation_parameters.solver_name
         = parameters.linear_programming_solver;
-    cgslds_parameters.new_solution_callback = [&instance, &algorithm_formatter](
+    cgslds_parameters.initial_columns = get_initial_columns(
+            instance,
+            parameters,
+            algorithm_formatter);
+    if (algorithm_formatter.optimal()) {
+        algorithm_formatter.end();
+        return output;
+    }
+    cgslds_parameters.new_solution_callback = [&instance, &algorithm_formatter, &end](
                 const columngenerationsolver::Output& cgs_output)
         {
             const columngenerationsolver::LimitedDiscrepancySearchOutput& cgslds_output
@@ -274,10 +731,9 @@ const Output coloringsolver::column_generation_heuristic_limited_discrepancy_sea
                 algorithm_formatter.update_solution(
                         columns2solution(instance, cgslds_output.solution.columns()),
                         ss.str());
+                if (algorithm_formatter.optimal())
+                    end = true;
             }
-            //algorithm_formatter.update_lower_bound(
-            //        std::ceil(o.bound - FFOT_TOL),
-            //        ss.str());
         };
     cgslds_parameters.column_generation_parameters.static_wentges_smoothing_parameter = 0.0;
     cgslds_parameters.column_generation_parameters.static_directional_smoothing_parameter = 0.0;
@@ -298,12 +754,29 @@ const Output coloringsolver::column_generation_heuristic_heuristic_tree_search(
     AlgorithmFormatter algorithm_formatter(parameters, output);
     algorithm_formatter.start("Column generation heuristic - Heuristic tree search");
     algorithm_formatter.print_header();
-
-    columngenerationsolver::Model model = get_model(instance);
+    algorithm_formatter.update_clique_bound();
+
+    // Stop as soon as the solution is optimal.
+    bool end = false;
+    columngenerationsolver::Model model = get_model(
+            instance,
+            parameters,
+            algorithm_formatter,
+            end);
     columngenerationsolver::HeuristicTreeSearchParameters cgshts_parameters;
     cgshts_parameters.column_generation_parameters.solver_name
         = parameters.linear_programming_solver;
-    cgshts_parameters.new_solution_callback = [&instance, &algorithm_formatter](
+    cgshts_parameters.initial_columns = get_initial_columns(
+            instance,
+            parameters,
+            algorithm_formatter);
+    if (algorithm_formatter.optimal()) {
+        algorithm_formatter.end();
+        return output;
+    }
+    cgshts_parameters.timer = parameters.timer;
+    cgshts_parameters.timer.add_end_boolean(&end);
+    cgshts_parameters.new_solution_callback = [&instance, &algorithm_formatter, &end](
                 const columngenerationsolver::Output& cgs_output)
         {
             const columngenerationsolver::HeuristicTreeSearchOutput& cgshts_output
@@ -314,6 +787,8 @@ const Output coloringsolver::column_generation_heuristic_heuristic_tree_search(
                 algorithm_formatter.update_solution(
                         columns2solution(instance, cgshts_output.solution.columns()),
                         ss.str());
+                if (algorithm_formatter.optimal())
+                    end = true;
             }
         };
     cgshts_parameters.column_generation_parameters.static_wentges_smoothing_parameter = 0.0;
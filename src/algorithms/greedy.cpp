@@ -1,8 +1,10 @@
 #include "coloringsolver/algorithms/greedy.hpp"
 
 #include "coloringsolver/algorithm_formatter.hpp"
+#include "coloringsolver/color_availability.hpp"
 
-#include "optimizationtools/containers/indexed_binary_heap.hpp"
+#include <atomic>
+#include <thread>
 
 using namespace coloringsolver;
 
@@ -53,9 +55,9 @@ std::ostream& coloringsolver::operator<<(
     return os;
 }
 
-std::vector<VertexId> largestfirst(const Instance& instance)
+template <typename Graph>
+std::vector<VertexId> largestfirst(const Graph& graph)
 {
-    const optimizationtools::AbstractGraph& graph = instance.graph();
     VertexId n = graph.number_of_vertices();
 
     std::vector<VertexId> ordered_vertices(n);
@@ -74,12 +76,14 @@ std::vector<VertexId> largestfirst(const Instance& instance)
     return ordered_vertices;
 }
 
-std::vector<VertexId> incidencedegree(const Instance& instance)
+template <typename Graph>
+std::vector<VertexId> incidencedegree(const Graph& graph)
 {
-    const optimizationtools::AbstractGraph& graph = instance.graph();
     VertexId n = graph.number_of_vertices();
 
     std::vector<VertexId> ordered_vertices(n);
+    if (n == 0)
+        return ordered_vertices;
     std::vector<uint8_t> added(n, 0);
     std::vector<std::vector<VertexId>> vertices(graph.highest_degree() + 1);
     std::vector<std::pair<VertexId, VertexPos>> positions(n, {-1, -1});
@@ -122,9 +126,9 @@ std::vector<VertexId> incidencedegree(const Instance& instance)
     return ordered_vertices;
 }
 
-std::vector<VertexId> smallestlast(const Instance& instance)
+template <typename Graph>
+std::vector<VertexId> smallestlast(const Graph& graph)
 {
-    const optimizationtools::AbstractGraph& graph = instance.graph();
     VertexId n = graph.number_of_vertices();
 
     std::vector<VertexId> ordered_vertices(n);
@@ -166,9 +170,9 @@ std::vector<VertexId> smallestlast(const Instance& instance)
     return ordered_vertices;
 }
 
-std::vector<VertexId> dynamiclargestfirst(const Instance& instance)
+template <typename Graph>
+std::vector<VertexId> dynamiclargestfirst(const Graph& graph)
 {
-    const optimizationtools::AbstractGraph& graph = instance.graph();
     VertexId n = graph.number_of_vertices();
 
     std::vector<VertexId> ordered_vertices(n);
@@ -207,18 +211,149 @@ std::vector<VertexId> dynamiclargestfirst(const Instance& instance)
     return ordered_vertices;
 }
 
-const Output coloringsolver::greedy(
-        const Instance& instance,
-        const GreedyParameters& parameters)
+namespace
 {
-    Output output(instance);
-    AlgorithmFormatter algorithm_formatter(parameters, output);
-    algorithm_formatter.start("Greedy");
-    algorithm_formatter.print_header();
 
-    const optimizationtools::AbstractGraph& graph = instance.graph();
+/**
+ * Split the range '[0, size)' into 'number_of_threads' contiguous chunks and
+ * call 'function(thread_id, begin, end)' on each chunk in its own thread.
+ *
+ * The chunk of a thread only depends on 'size' and on 'number_of_threads'.
+ */
+template <typename Function>
+void greedy_parallel_for(
+        Counter number_of_threads,
+        VertexPos size,
+        const Function& function)
+{
+    if (number_of_threads == 1) {
+        function(0, 0, size);
+        return;
+    }
+    std::vector<std::thread> threads;
+    for (Counter thread_id = 0; thread_id < number_of_threads; ++thread_id) {
+        VertexPos begin = size * thread_id / number_of_threads;
+        VertexPos end = size * (thread_id + 1) / number_of_threads;
+        threads.push_back(std::thread(function, thread_id, begin, end));
+    }
+    for (std::thread& thread: threads)
+        thread.join();
+}
+
+/**
+ * Color the vertices speculatively in parallel following an ordering, then
+ * recolor the conflicting vertices until there is no conflict.
+ *
+ * See "Scalable Parallel Graph Coloring Algorithms" (Gebremedhin et Manne,
+ * 2000). When two neighbors have the same color, the one which comes later in
+ * the ordering is recolored. At each round, the first vertex of the ordering
+ * which still needs to be colored gets its final color, so the number of
+ * rounds is bounded by the number of vertices.
+ */
+template <typename Graph>
+void greedy_speculative(
+        const Graph& graph,
+        const std::vector<VertexId>& ordered_vertices,
+        Counter number_of_threads,
+        Solution& solution)
+{
+    VertexId n = graph.number_of_vertices();
+
+    std::vector<VertexPos> positions(n);
+    for (VertexPos vertex_pos = 0; vertex_pos < n; ++vertex_pos)
+        positions[ordered_vertices[vertex_pos]] = vertex_pos;
+
+    // The colors of the neighbors are read while other threads may write
+    // them, therefore, they are stored in atomics.
+    std::vector<std::atomic<ColorId>> colors(n);
+    for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id)
+        colors[vertex_id].store(-1, std::memory_order_relaxed);
+
+    std::vector<VertexId> vertices_to_color = ordered_vertices;
+    std::vector<std::vector<VertexId>> conflicting_vertices(number_of_threads);
+    std::vector<ColorAvailability> color_availabilities(
+            number_of_threads,
+            ColorAvailability(graph.highest_degree() + 1));
+    while (!vertices_to_color.empty()) {
+
+        // Color the vertices speculatively.
+        // The vertices are distributed in a round-robin fashion, so that all
+        // threads move forward in the ordering together.
+        greedy_parallel_for(
+                number_of_threads,
+                number_of_threads,
+                [&](Counter thread_id, VertexPos, VertexPos)
+                {
+                    ColorAvailability& color_availability
+                        = color_availabilities[thread_id];
+                    for (VertexPos vertex_pos = thread_id;
+                            vertex_pos < (VertexPos)vertices_to_color.size();
+                            vertex_pos += number_of_threads) {
+                        VertexId vertex_id = vertices_to_color[vertex_pos];
+                        color_availability.clear();
+                        auto it = graph.neighbors_begin(vertex_id);
+                        auto it_end = graph.neighbors_end(vertex_id);
+                        for (; it != it_end; ++it) {
+                            ColorId color_id = colors[*it].load(std::memory_order_relaxed);
+                            if (color_id != -1)
+                                color_availability.forbid(color_id);
+                        }
+                        colors[vertex_id].store(
+                                color_availability.first_available(),
+                                std::memory_order_relaxed);
+                    }
+                });
+
+        // Detect the conflicts.
+        greedy_parallel_for(
+                number_of_threads,
+                vertices_to_color.size(),
+                [&](Counter thread_id, VertexPos begin, VertexPos end)
+                {
+                    conflicting_vertices[thread_id].clear();
+                    for (VertexPos vertex_pos = begin;
+                            vertex_pos < end;
+                            ++vertex_pos) {
+                        VertexId vertex_id = vertices_to_color[vertex_pos];
+                        ColorId color_id = colors[vertex_id].load(std::memory_order_relaxed);
+                        auto it = graph.neighbors_begin(vertex_id);
+                        auto it_end = graph.neighbors_end(vertex_id);
+                        for (; it != it_end; ++it) {
+                            VertexId vertex_id_neighbor = *it;
+                            if (colors[vertex_id_neighbor].load(std::memory_order_relaxed) == color_id
+                                    && positions[vertex_id_neighbor] < positions[vertex_id]) {
+                                conflicting_vertices[thread_id].push_back(vertex_id);
+                                break;
+                            }
+                        }
+                    }
+                });
+
+        // Uncolor the conflicting vertices.
+        // 'vertices_to_color' remains sorted by position in the ordering.
+        vertices_to_color.clear();
+        for (Counter thread_id = 0; thread_id < number_of_threads; ++thread_id) {
+            for (VertexId vertex_id: conflicting_vertices[thread_id]) {
+                colors[vertex_id].store(-1, std::memory_order_relaxed);
+                vertices_to_color.push_back(vertex_id);
+            }
+        }
+    }
+
+    for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id)
+        solution.set(vertex_id, colors[vertex_id].load(std::memory_order_relaxed), false);
+}
+
+/**
+ * Color the vertices of a graph following one of the orderings.
+ */
+template <typename Graph>
+void greedy_color(
+        const Graph& graph,
+        const GreedyParameters& parameters,
+        Solution& solution)
+{
     VertexId n = graph.number_of_vertices();
-    Solution solution(instance);
 
     std::vector<VertexId> ordered_vertices;
     switch (parameters.ordering) {
@@ -227,140 +362,576 @@ const Output coloringsolver::greedy(
         std::iota(ordered_vertices.begin(), ordered_vertices.end(), 0);
         break;
     } case Ordering::LargestFirst: {
-        ordered_vertices = largestfirst(instance);
+        ordered_vertices = largestfirst(graph);
         break;
     } case Ordering::IncidenceDegree: {
-        ordered_vertices = incidencedegree(instance);
+        ordered_vertices = incidencedegree(graph);
         break;
     } case Ordering::SmallestLast: {
-        ordered_vertices = smallestlast(instance);
+        ordered_vertices = smallestlast(graph);
         break;
     } case Ordering::DynamicLargestFirst: {
-        ordered_vertices = dynamiclargestfirst(instance);
+        ordered_vertices = dynamiclargestfirst(graph);
         break;
     } default: {
     }
     }
 
-    optimizationtools::IndexedSet color_set(graph.highest_degree() + 1);
+    if (parameters.number_of_threads > 1) {
+        if (parameters.reverse)
+            std::reverse(ordered_vertices.begin(), ordered_vertices.end());
+        greedy_speculative(
+                graph,
+                ordered_vertices,
+                parameters.number_of_threads,
+                solution);
+        return;
+    }
+
+    ColorAvailability color_availability(graph.highest_degree() + 1);
     if (!parameters.reverse) {
         for (auto it_v = ordered_vertices.begin(); it_v != ordered_vertices.end(); ++it_v) {
             VertexId vertex_id = *it_v;
-            color_set.clear();
+            color_availability.clear();
             auto it = graph.neighbors_begin(vertex_id);
             auto it_end = graph.neighbors_end(vertex_id);
             for (; it != it_end; ++it) {
                 VertexId vertex_id_neighbor = *it;
                 if (solution.contains(vertex_id_neighbor))
-                    color_set.add(solution.color(vertex_id_neighbor));
-            }
-            ColorId color_id_best = -1;
-            for (ColorId color_id = 0; color_id < n; ++color_id) {
-                if (!color_set.contains(color_id)) {
-                    color_id_best = color_id;
-                    break;
-                }
+                    color_availability.forbid(solution.color(vertex_id_neighbor));
             }
+            ColorId color_id_best = color_availability.first_available();
             solution.set(vertex_id, color_id_best, false);
         }
     } else {
         for (auto it_v = ordered_vertices.rbegin(); it_v != ordered_vertices.rend(); ++it_v) {
             VertexId vertex_id = *it_v;
-            color_set.clear();
+            color_availability.clear();
             auto it = graph.neighbors_begin(vertex_id);
             auto it_end = graph.neighbors_end(vertex_id);
             for (; it != it_end; ++it) {
                 VertexId vertex_id_neighbor = *it;
                 if (solution.contains(vertex_id_neighbor))
-                    color_set.add(solution.color(vertex_id_neighbor));
-            }
-            ColorId color_id_best = -1;
-            for (ColorId color_id = 0; color_id < n; ++color_id) {
-                if (!color_set.contains(color_id)) {
-                    color_id_best = color_id;
-                    break;
-                }
+                    color_availability.forbid(solution.color(vertex_id_neighbor));
             }
+            ColorId color_id_best = color_availability.first_available();
             solution.set(vertex_id, color_id_best, false);
         }
     }
+}
 
-    algorithm_formatter.update_solution(solution, "");
-
-    algorithm_formatter.end();
-    return output;
 }
 
-const Output coloringsolver::greedy_dsatur(
+const Output coloringsolver::greedy(
         const Instance& instance,
-        const Parameters& parameters)
+        const GreedyParameters& parameters)
 {
     Output output(instance);
     AlgorithmFormatter algorithm_formatter(parameters, output);
-    algorithm_formatter.start("DSATUR");
+    algorithm_formatter.start("Greedy");
     algorithm_formatter.print_header();
+    algorithm_formatter.update_clique_bound();
+
+    if (parameters.number_of_threads < 1) {
+        throw std::invalid_argument(
+                "The number of threads must be at least 1.");
+    }
 
-    const optimizationtools::AbstractGraph& graph = instance.graph();
-    VertexId n = graph.number_of_vertices();
     Solution solution(instance);
+    if (instance.compact_graph() != nullptr) {
+        greedy_color(*instance.compact_graph(), parameters, solution);
+    } else {
+        greedy_color(instance.graph(), parameters, solution);
+    }
 
-    VertexId vertex_id_best = -1;
-    for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id)
-        if (vertex_id_best == -1
-                || graph.degree(vertex_id_best) < graph.degree(vertex_id))
-            vertex_id_best = vertex_id;
+    algorithm_formatter.update_solution(solution, "");
+
+    algorithm_formatter.end();
+    return output;
+}
+
+namespace
+{
+
+/**
+ * Bucket queue storing the uncolored vertices by saturation and by degree.
+ *
+ * The degrees are replaced by their rank among the distinct degrees of the
+ * graph, so that the number of buckets of a saturation level is at most
+ * O(sqrt(m)). The levels are allocated when they are reached. Inserting,
+ * removing and increasing the saturation of a vertex take constant time.
+ */
+class DsaturBucketQueue
+{
+
+public:
+
+    /** Constructor. */
+    template <typename Graph>
+    DsaturBucketQueue(const Graph& graph):
+        degree_ranks_(graph.number_of_vertices()),
+        saturations_(graph.number_of_vertices(), 0),
+        nexts_(graph.number_of_vertices(), -1),
+        previouses_(graph.number_of_vertices(), -1)
+    {
+        // Compute the ranks of the degrees, the highest degree having rank 0.
+        std::vector<VertexId> ranks(graph.highest_degree() + 1, -1);
+        for (VertexId vertex_id = 0;
+                vertex_id < graph.number_of_vertices();
+                ++vertex_id) {
+            ranks[graph.degree(vertex_id)] = 0;
+        }
+        for (VertexId degree = graph.highest_degree(); degree >= 0; --degree)
+            if (ranks[degree] == 0)
+                ranks[degree] = number_of_degree_ranks_++;
+        for (VertexId vertex_id = 0;
+                vertex_id < graph.number_of_vertices();
+                ++vertex_id) {
+            degree_ranks_[vertex_id] = ranks[graph.degree(vertex_id)];
+            insert(vertex_id);
+        }
+    }
+
+    /** Return 'true' iff the queue is empty. */
+    inline bool empty() const { return size_ == 0; }
+
+    /** Get the saturation of a vertex. */
+    inline ColorId saturation(VertexId vertex_id) const { return saturations_[vertex_id]; }
+
+    /** Get a vertex with maximum saturation and, then, maximum degree. */
+    inline VertexId top() const { return heads_[saturation_max_][top_ranks_[saturation_max_]]; }
+
+    /** Remove a vertex from the queue. */
+    inline void remove(VertexId vertex_id)
+    {
+        ColorId saturation = saturations_[vertex_id];
+        VertexId degree_rank = degree_ranks_[vertex_id];
+        if (previouses_[vertex_id] != -1) {
+            nexts_[previouses_[vertex_id]] = nexts_[vertex_id];
+        } else {
+            heads_[saturation][degree_rank] = nexts_[vertex_id];
+        }
+        if (nexts_[vertex_id] != -1)
+            previouses_[nexts_[vertex_id]] = previouses_[vertex_id];
+        size_--;
+
+        // Update the top ranks and the maximum saturation.
+        while (top_ranks_[saturation] < number_of_degree_ranks_
+                && heads_[saturation][top_ranks_[saturation]] == -1) {
+            top_ranks_[saturation]++;
+        }
+        while (saturation_max_ > 0
+                && top_ranks_[saturation_max_] == number_of_degree_ranks_) {
+            saturation_max_--;
+        }
+    }
+
+    /** Increase the saturation of a vertex by one. */
+    inline void increment_saturation(VertexId vertex_id)
+    {
+        remove(vertex_id);
+        saturations_[vertex_id]++;
+        insert(vertex_id);
+    }
+
+private:
+
+    /** Insert a vertex at its saturation level. */
+    inline void insert(VertexId vertex_id)
+    {
+        ColorId saturation = saturations_[vertex_id];
+        VertexId degree_rank = degree_ranks_[vertex_id];
+        if (saturation == (ColorId)heads_.size()) {
+            heads_.push_back(std::vector<VertexId>(number_of_degree_ranks_, -1));
+            top_ranks_.push_back(number_of_degree_ranks_);
+        }
+        VertexId& head = heads_[saturation][degree_rank];
+        previouses_[vertex_id] = -1;
+        nexts_[vertex_id] = head;
+        if (head != -1)
+            previouses_[head] = vertex_id;
+        head = vertex_id;
+        size_++;
+        top_ranks_[saturation] = std::min(top_ranks_[saturation], degree_rank);
+        saturation_max_ = std::max(saturation_max_, saturation);
+    }
+
+    /** Number of distinct degrees. */
+    VertexId number_of_degree_ranks_ = 0;
+
+    /** Rank of the degree of each vertex. */
+    std::vector<VertexId> degree_ranks_;
 
-    auto f = [](VertexId) { return 0; };
-    optimizationtools::IndexedBinaryHeap<double> heap(n, f);
-    heap.update_key(vertex_id_best, -1);
+    /** Saturation of each vertex. */
+    std::vector<ColorId> saturations_;
 
-    optimizationtools::IndexedSet color_set(graph.highest_degree() + 1);
+    /** First vertex of each bucket, by saturation and by degree rank. */
+    std::vector<std::vector<VertexId>> heads_;
 
-    std::vector<std::vector<bool>> is_adjacent;
-    std::vector<ColorId> number_of_adjacent_colors(n, 0);
-    while (!solution.feasible()) {
-        auto p = heap.top();
-        heap.pop();
+    /** Smallest non-empty degree rank of each saturation level. */
+    std::vector<VertexId> top_ranks_;
 
-        color_set.clear();
-        VertexId vertex_id = p.first;
+    /** Next vertex in the bucket of each vertex. */
+    std::vector<VertexId> nexts_;
+
+    /** Previous vertex in the bucket of each vertex. */
+    std::vector<VertexId> previouses_;
+
+    /** Highest non-empty saturation level. */
+    ColorId saturation_max_ = 0;
+
+    /** Number of vertices in the queue. */
+    VertexId size_ = 0;
+
+};
+
+/**
+ * Sets of the colors adjacent to each vertex.
+ *
+ * The sets are stored in a single bitmap with one row of 'row_size_' 64-bit
+ * words per vertex. The rows are widened when a color doesn't fit, so the
+ * memory is about 'n * k' bits, 'k' being the number of colors used.
+ */
+class AdjacentColorSets
+{
+
+public:
+
+    /** Constructor. */
+    AdjacentColorSets(VertexId number_of_vertices):
+        number_of_vertices_(number_of_vertices),
+        words_(number_of_vertices, 0) { }
+
+    /**
+     * Add a color to the set of a vertex.
+     *
+     * Return 'false' if the color was already in the set.
+     */
+    inline bool add(
+            VertexId vertex_id,
+            ColorId color_id)
+    {
+        if ((color_id >> 6) >= row_size_)
+            widen(color_id);
+        uint64_t& word = words_[vertex_id * row_size_ + (color_id >> 6)];
+        uint64_t bit = (uint64_t)1 << (color_id & 63);
+        if (word & bit)
+            return false;
+        word |= bit;
+        return true;
+    }
+
+private:
+
+    /** Double the size of the rows until a color fits. */
+    void widen(ColorId color_id)
+    {
+        ColorId row_size = row_size_;
+        while ((color_id >> 6) >= row_size)
+            row_size *= 2;
+        std::vector<uint64_t> words(number_of_vertices_ * row_size, 0);
+        for (VertexId vertex_id = 0;
+                vertex_id < number_of_vertices_;
+                ++vertex_id) {
+            std::copy(
+                    words_.begin() + vertex_id * row_size_,
+                    words_.begin() + (vertex_id + 1) * row_size_,
+                    words.begin() + vertex_id * row_size);
+        }
+        words_.swap(words);
+        row_size_ = row_size;
+    }
+
+    /** Number of vertices. */
+    VertexId number_of_vertices_;
+
+    /** Number of words of the row of each vertex. */
+    ColorId row_size_ = 1;
+
+    /** Bitmap. */
+    std::vector<uint64_t> words_;
+
+};
+
+/**
+ * Color the vertices of a graph with the DSATUR algorithm.
+ */
+template <typename Graph>
+void greedy_dsatur_color(
+        const Graph& graph,
+        Solution& solution)
+{
+    DsaturBucketQueue queue(graph);
+    AdjacentColorSets adjacent_colors(graph.number_of_vertices());
+    ColorAvailability color_availability(graph.highest_degree() + 1);
+
+    while (!queue.empty()) {
+        VertexId vertex_id = queue.top();
+        queue.remove(vertex_id);
+
+        color_availability.clear();
         auto it_begin = graph.neighbors_begin(vertex_id);
         auto it_end = graph.neighbors_end(vertex_id);
         for (auto it = it_begin; it != it_end; ++it) {
             VertexId vertex_id_neighbor = *it;
             if (solution.contains(vertex_id_neighbor))
-                color_set.add(solution.color(vertex_id_neighbor));
+                color_availability.forbid(solution.color(vertex_id_neighbor));
         }
-
-        ColorId color_id_best = -1;
-        for (ColorId color_id = 0; color_id < n; ++color_id) {
-            if (!color_set.contains(color_id)) {
-                color_id_best = color_id;
-                break;
-            }
-        }
-        if (color_id_best >= (ColorId)is_adjacent.size()) {
-            is_adjacent.push_back(std::vector<bool>(n, false));
-        }
-
-        solution.set(p.first, color_id_best, false);
+        ColorId color_id_best = color_availability.first_available();
+        solution.set(vertex_id, color_id_best, false);
 
         for (auto it = it_begin; it != it_end; ++it) {
             VertexId vertex_id_neighbor = *it;
             if (solution.contains(vertex_id_neighbor))
                 continue;
-            if (is_adjacent[color_id_best][vertex_id_neighbor])
-                continue;
-            is_adjacent[color_id_best][vertex_id_neighbor] = true;
-            number_of_adjacent_colors[vertex_id_neighbor]++;
-            double val = -number_of_adjacent_colors[vertex_id_neighbor]
-                - (double)graph.degree(vertex_id_neighbor) / (graph.highest_degree() + 1);
-            heap.update_key(vertex_id_neighbor, val);
+            if (adjacent_colors.add(vertex_id_neighbor, color_id_best))
+                queue.increment_saturation(vertex_id_neighbor);
         }
     }
+}
 
+/**
+ * Color the vertices of a graph with the Jones-Plassmann algorithm.
+ */
+template <typename Graph>
+void greedy_jones_plassmann_color(
+        const Graph& graph,
+        const std::vector<uint64_t>& priorities,
+        const GreedyJonesPlassmannParameters& parameters,
+        Solution& solution)
+{
+    VertexId n = graph.number_of_vertices();
+    Counter number_of_threads = parameters.number_of_threads;
+
+    // Ties are broken by vertex id.
+    auto has_priority = [&priorities](
+            VertexId vertex_id_1,
+            VertexId vertex_id_2)
+    {
+        return priorities[vertex_id_1] > priorities[vertex_id_2]
+            || (priorities[vertex_id_1] == priorities[vertex_id_2]
+                    && vertex_id_1 < vertex_id_2);
+    };
+
+    // Colors are written in a plain vector, since the vertices colored during
+    // a round are not adjacent and their neighbors are not modified.
+    std::vector<ColorId> colors(n, -1);
+    std::vector<VertexId> uncolored_vertices(n);
+    std::iota(uncolored_vertices.begin(), uncolored_vertices.end(), 0);
+    std::vector<std::vector<VertexId>> selected_vertices(number_of_threads);
+    std::vector<std::vector<VertexId>> remaining_vertices(number_of_threads);
+    std::vector<ColorAvailability> color_availabilities(
+            number_of_threads,
+            ColorAvailability(graph.highest_degree() + 1));
+
+    while (!uncolored_vertices.empty()) {
+        if (parameters.timer.needs_to_end())
+            break;
+
+        // Select the uncolored vertices having a higher priority than all
+        // their uncolored neighbors.
+        greedy_parallel_for(
+                number_of_threads,
+                uncolored_vertices.size(),
+                [&](Counter thread_id, VertexPos begin, VertexPos end)
+                {
+                    selected_vertices[thread_id].clear();
+                    remaining_vertices[thread_id].clear();
+                    for (VertexPos vertex_pos = begin;
+                            vertex_pos < end;
+                            ++vertex_pos) {
+                        VertexId vertex_id = uncolored_vertices[vertex_pos];
+                        bool selected = true;
+                        auto it = graph.neighbors_begin(vertex_id);
+                        auto it_end = graph.neighbors_end(vertex_id);
+                        for (; it != it_end; ++it) {
+                            VertexId vertex_id_neighbor = *it;
+                            if (colors[vertex_id_neighbor] == -1
+                                    && has_priority(vertex_id_neighbor, vertex_id)) {
+                                selected = false;
+                                break;
+                            }
+                        }
+                        if (selected) {
+                            selected_vertices[thread_id].push_back(vertex_id);
+                        } else {
+                            remaining_vertices[thread_id].push_back(vertex_id);
+                        }
+                    }
+                });
+
+        // Color the selected vertices.
+        greedy_parallel_for(
+                number_of_threads,
+                number_of_threads,
+                [&](Counter thread_id, VertexPos, VertexPos)
+                {
+                    ColorAvailability& color_availability
+                        = color_availabilities[thread_id];
+                    for (VertexId vertex_id: selected_vertices[thread_id]) {
+                        color_availability.clear();
+                        auto it = graph.neighbors_begin(vertex_id);
+                        auto it_end = graph.neighbors_end(vertex_id);
+                        for (; it != it_end; ++it) {
+                            VertexId vertex_id_neighbor = *it;
+                            if (colors[vertex_id_neighbor] != -1)
+                                color_availability.forbid(colors[vertex_id_neighbor]);
+                        }
+                        colors[vertex_id] = color_availability.first_available();
+                    }
+                });
+
+        // Update the uncolored vertices.
+        uncolored_vertices.clear();
+        for (Counter thread_id = 0; thread_id < number_of_threads; ++thread_id) {
+            uncolored_vertices.insert(
+                    uncolored_vertices.end(),
+                    remaining_vertices[thread_id].begin(),
+                    remaining_vertices[thread_id].end());
+        }
+    }
+
+    for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id)
+        if (colors[vertex_id] != -1)
+            solution.set(vertex_id, colors[vertex_id], false);
+}
+
+}
+
+const Output coloringsolver::greedy_dsatur(
+        const Instance& instance,
+        const GreedyDsaturParameters& parameters)
+{
+    Output output(instance);
+    AlgorithmFormatter algorithm_formatter(parameters, output);
+    algorithm_formatter.start("DSATUR");
+    algorithm_formatter.print_header();
+    algorithm_formatter.update_clique_bound();
+
+    Solution solution(instance);
+    if (instance.compact_graph() != nullptr) {
+        greedy_dsatur_color(*instance.compact_graph(), solution);
+    } else {
+        greedy_dsatur_color(instance.graph(), solution);
+    }
+
+    algorithm_formatter.update_solution(solution, "");
+
+    algorithm_formatter.end();
+    return output;
+}
+
+const Output coloringsolver::greedy_jones_plassmann(
+        const Instance& instance,
+        std::mt19937_64& generator,
+        const GreedyJonesPlassmannParameters& parameters)
+{
+    Output output(instance);
+    AlgorithmFormatter algorithm_formatter(parameters, output);
+    algorithm_formatter.start("Jones-Plassmann greedy");
+    algorithm_formatter.print_header();
+    algorithm_formatter.update_clique_bound();
+
+    if (parameters.number_of_threads < 1) {
+        throw std::invalid_argument(
+                "The number of threads must be at least 1.");
+    }
+
+    // Draw the priorities.
+    std::vector<uint64_t> priorities(instance.number_of_vertices());
+    for (VertexId vertex_id = 0;
+            vertex_id < instance.number_of_vertices();
+            ++vertex_id) {
+        priorities[vertex_id] = generator();
+    }
+
+    Solution solution(instance);
+    if (instance.compact_graph() != nullptr) {
+        greedy_jones_plassmann_color(
+                *instance.compact_graph(),
+                priorities,
+                parameters,
+                solution);
+    } else {
+        greedy_jones_plassmann_color(
+                instance.graph(),
+                priorities,
+                parameters,
+                solution);
+    }
     algorithm_formatter.update_solution(solution, "");
 
     algorithm_formatter.end();
     return output;
 }
+
+const Output coloringsolver::greedy_repair(
+        const Solution& initial_solution,
+        const Parameters& parameters)
+{
+    const Instance& instance = initial_solution.instance();
+    const optimizationtools::AbstractGraph& graph = instance.graph();
+    Output output(instance);
+    AlgorithmFormatter algorithm_formatter(parameters, output);
+    algorithm_formatter.start("Greedy repair");
+    algorithm_formatter.print_header();
+
+    // Uncolor the conflicting vertices with the most conflicts first, until
+    // there is no conflict left.
+    Solution solution = initial_solution;
+    std::vector<VertexId> conflicting_vertices;
+    for (VertexId vertex_id = 0; vertex_id < graph.number_of_vertices(); ++vertex_id)
+        if (solution.contains(vertex_id)
+                && solution.conflicting_vertices()[vertex_id] > 0)
+            conflicting_vertices.push_back(vertex_id);
+    std::stable_sort(
+            conflicting_vertices.begin(),
+            conflicting_vertices.end(),
+            [&initial_solution](VertexId vertex_id_1, VertexId vertex_id_2)
+            {
+                return initial_solution.conflicting_vertices()[vertex_id_1]
+                    > initial_solution.conflicting_vertices()[vertex_id_2];
+            });
+    for (VertexId vertex_id: conflicting_vertices)
+        if (solution.conflicting_vertices()[vertex_id] > 0)
+            solution.set(vertex_id, -1);
+
+    // Renumber the remaining colors from 0.
+    Solution solution_repaired(instance);
+    std::vector<ColorId> color_ids(graph.number_of_vertices(), -1);
+    ColorId number_of_colors = 0;
+    std::vector<VertexId> uncolored_vertices;
+    for (VertexId vertex_id = 0; vertex_id < graph.number_of_vertices(); ++vertex_id) {
+        if (!solution.contains(vertex_id)) {
+            uncolored_vertices.push_back(vertex_id);
+            continue;
+        }
+        ColorId color_id = solution.color(vertex_id);
+        if (color_ids[color_id] == -1)
+            color_ids[color_id] = number_of_colors++;
+        solution_repaired.set(vertex_id, color_ids[color_id]);
+    }
+
+    // Color the uncolored vertices by non-increasing degree.
+    std::stable_sort(
+            uncolored_vertices.begin(),
+            uncolored_vertices.end(),
+            [&graph](VertexId vertex_id_1, VertexId vertex_id_2)
+            {
+                return graph.degree(vertex_id_1) > graph.degree(vertex_id_2);
+            });
+    ColorAvailability color_availability(graph.number_of_vertices());
+    for (VertexId vertex_id: uncolored_vertices) {
+        color_availability.clear();
+        auto it = graph.neighbors_begin(vertex_id);
+        auto it_end = graph.neighbors_end(vertex_id);
+        for (; it != it_end; ++it)
+            if (solution_repaired.contains(*it))
+                color_availability.forbid(solution_repaired.color(*it));
+        solution_repaired.set(vertex_id, color_availability.first_available());
+    }
+    algorithm_formatter.update_solution(solution_repaired, "");
+
+    algorithm_formatter.end();
+    return output;
+}
@@ -1,11 +1,353 @@
 #include "coloringsolver/algorithms/local_search_row_weighting.hpp"
 
 #include "coloringsolver/algorithm_formatter.hpp"
+#include "coloringsolver/color_availability.hpp"
 
 #include "coloringsolver/algorithms/greedy.hpp"
 
+#include <mutex>
+#include <thread>
+
 using namespace coloringsolver;
 
+namespace
+{
+
+/**
+ * Table storing, for each vertex and each color, the sum of the penalties of
+ * the neighbors of the vertex having this color.
+ *
+ * This is the 'gamma' matrix of TabuCol. It is maintained incrementally when
+ * the color of a vertex or a penalty changes, so that evaluating all the
+ * recoloring moves of a vertex is a read of its row in O(k) instead of a scan
+ * of its neighbors in O(degree).
+ *
+ * The entries are single penalties. The local searches keep the sum of the
+ * penalties of the neighbors of each vertex, which bounds its row, below
+ * 'local_search_row_weighting_maximum_penalty'.
+ */
+class AdjacentColorPenalties
+{
+
+public:
+
+    /** Constructor. */
+    AdjacentColorPenalties(
+            VertexId number_of_vertices,
+            ColorId number_of_colors):
+        number_of_colors_(number_of_colors),
+        penalties_(number_of_vertices * number_of_colors, 0) { }
+
+    /** Get the penalty of the neighbors of a vertex having a given color. */
+    inline Penalty penalty(
+            VertexId vertex_id,
+            ColorId color_id) const
+    {
+        return penalties_[vertex_id * number_of_colors_ + color_id];
+    }
+
+    /** Add a penalty to the neighbors of a vertex having a given color. */
+    inline void add(
+            VertexId vertex_id,
+            ColorId color_id,
+            Penalty penalty)
+    {
+        penalties_[vertex_id * number_of_colors_ + color_id] += penalty;
+    }
+
+    /**
+     * Move the penalty of an element from color 'color_id_old' to color
+     * 'color_id' in the row of a vertex. '-1' stands for no color.
+     */
+    inline void move(
+            VertexId vertex_id,
+            ColorId color_id_old,
+            Penalty penalty_old,
+            ColorId color_id,
+            Penalty penalty)
+    {
+        Penalty* row = penalties_.data() + vertex_id * number_of_colors_;
+        if (color_id_old != -1)
+            row[color_id_old] -= penalty_old;
+        if (color_id != -1)
+            row[color_id] += penalty;
+    }
+
+    /** Get the number of colors. */
+    inline ColorId number_of_colors() const { return number_of_colors_; }
+
+    /** Get the row of a vertex. */
+    inline const Penalty* row(VertexId vertex_id) const
+    {
+        return penalties_.data() + vertex_id * number_of_colors_;
+    }
+
+    /** Reset all penalties to 0. */
+    inline void clear() { std::fill(penalties_.begin(), penalties_.end(), 0); }
+
+    /** Return 'true' iff two tables contain the same penalties. */
+    inline bool operator==(const AdjacentColorPenalties& adjacent_color_penalties) const
+    {
+        return number_of_colors_ == adjacent_color_penalties.number_of_colors_
+            && penalties_ == adjacent_color_penalties.penalties_;
+    }
+
+private:
+
+    /** Number of colors. */
+    ColorId number_of_colors_;
+
+    /** Flat 'number_of_vertices x number_of_colors' penalty table. */
+    std::vector<Penalty> penalties_;
+
+};
+
+/**
+ * Maximum sum of the penalties of the neighbors of a vertex.
+ *
+ * Above it, the penalties are rescaled, so that the entries of the adjacent
+ * color penalty table can't overflow.
+ */
+const PenaltySum local_search_row_weighting_maximum_penalty
+    = std::numeric_limits<Penalty>::max() / 2;
+
+/**
+ * Penalty increment above which the penalties are rescaled.
+ *
+ * An increment can be added to a sum just below
+ * 'local_search_row_weighting_maximum_penalty' without overflowing.
+ */
+const Penalty local_search_row_weighting_maximum_penalty_increment
+    = std::numeric_limits<Penalty>::max() / 4;
+
+/**
+ * Return 'true' iff a penalty has reached the decay threshold.
+ *
+ * The penalties are stored multiplied by the current penalty increment, so
+ * the threshold is compared with 'penalty / penalty_increment'.
+ */
+inline bool local_search_row_weighting_decay(
+        Penalty penalty,
+        Penalty penalty_increment,
+        Penalty penalty_decay_threshold)
+{
+    return penalty_decay_threshold != -1
+        && penalty > (PenaltySum)penalty_decay_threshold * penalty_increment;
+}
+
+/**
+ * Rescale penalties so that the penalty increment is 1 again.
+ *
+ * The penalties are divided by the increment, rounding up. If the increment
+ * is already 1, they are halved instead.
+ *
+ * This takes O(number of penalties), but only happens once every
+ * 'log2(local_search_row_weighting_maximum_penalty_increment)' decays, or
+ * when the sums of penalties really get close to overflowing.
+ */
+inline void local_search_row_weighting_rescale(
+        std::vector<Penalty>& penalties,
+        Penalty& penalty_increment)
+{
+    Penalty divisor = std::max(penalty_increment, (Penalty)2);
+    for (Penalty& penalty: penalties)
+        penalty = (penalty - 1) / divisor + 1;
+    penalty_increment = 1;
+}
+
+/**
+ * Triangular table storing, for each pair of distinct colors, the sum of the
+ * penalties of the edges between vertices of these two colors.
+ *
+ * It is allocated once and maintained incrementally when a vertex changes
+ * color, so that choosing the two colors to merge when the solution becomes
+ * feasible doesn't require a scan of all the edges.
+ */
+class ColorPairPenalties
+{
+
+public:
+
+    /** Constructor. */
+    ColorPairPenalties(ColorId number_of_colors):
+        number_of_colors_(number_of_colors),
+        row_offsets_(number_of_colors),
+        penalties_(number_of_colors * (number_of_colors - 1) / 2, 0),
+        neighbor_counts_(number_of_colors + 1, 0)
+    {
+        for (ColorId color_id = 0; color_id < number_of_colors; ++color_id) {
+            row_offsets_[color_id] = color_id * (2 * number_of_colors - color_id - 1) / 2
+                - color_id - 1;
+        }
+    }
+
+    /** Get the penalty between two distinct colors. */
+    inline PenaltySum penalty(
+            ColorId color_id_1,
+            ColorId color_id_2) const
+    {
+        return penalties_[index(color_id_1, color_id_2)];
+    }
+
+    /**
+     * Add a penalty between two colors.
+     *
+     * Nothing is done if one of the colors is '-1' or if both colors are the
+     * same.
+     */
+    inline void add(
+            ColorId color_id_1,
+            ColorId color_id_2,
+            PenaltySum penalty)
+    {
+        if (color_id_1 == -1
+                || color_id_2 == -1
+                || color_id_1 == color_id_2) {
+            return;
+        }
+        penalties_[index(color_id_1, color_id_2)] += penalty;
+    }
+
+    /**
+     * Register the color of a neighbor of the next vertex to move.
+     *
+     * Only needed when the penalties of the edges depend on the penalty of
+     * the moved vertex.
+     */
+    inline void add_neighbor(ColorId color_id) { neighbor_counts_[color_id + 1]++; }
+
+    /**
+     * Move a vertex from color 'color_id_old' to color 'color_id'. '-1'
+     * stands for no color.
+     *
+     * The penalty of the edges between the vertex and its neighbors of color
+     * 'c' is 'adjacent_color_penalties[c]' plus 'vertex_penalty' times the
+     * number of neighbors of color 'c' registered with 'add_neighbor' since
+     * the last move.
+     *
+     * This takes O(k) instead of O(degree).
+     */
+    inline void move(
+            ColorId color_id_old,
+            ColorId color_id,
+            const Penalty* adjacent_color_penalties,
+            Penalty vertex_penalty = 0)
+    {
+        for (ColorId color_id_2 = 0;
+                color_id_2 < number_of_colors_;
+                ++color_id_2) {
+            PenaltySum penalty = (PenaltySum)adjacent_color_penalties[color_id_2]
+                + (PenaltySum)vertex_penalty * neighbor_counts_[color_id_2 + 1];
+            if (color_id_old != -1 && color_id_2 != color_id_old)
+                penalties_[index(color_id_old, color_id_2)] -= penalty;
+            if (color_id != -1 && color_id_2 != color_id)
+                penalties_[index(color_id, color_id_2)] += penalty;
+        }
+        std::fill(neighbor_counts_.begin(), neighbor_counts_.end(), 0);
+    }
+
+    /** Reset all penalties to 0. */
+    inline void clear() { std::fill(penalties_.begin(), penalties_.end(), 0); }
+
+    /** Return 'true' iff two tables contain the same penalties. */
+    inline bool operator==(const ColorPairPenalties& color_pair_penalties) const
+    {
+        return number_of_colors_ == color_pair_penalties.number_of_colors_
+            && penalties_ == color_pair_penalties.penalties_;
+    }
+
+private:
+
+    /** Get the index of a pair of distinct colors in 'penalties_'. */
+    inline std::size_t index(
+            ColorId color_id_1,
+            ColorId color_id_2) const
+    {
+        return row_offsets_[std::min(color_id_1, color_id_2)]
+            + std::max(color_id_1, color_id_2);
+    }
+
+    /** Number of colors. */
+    ColorId number_of_colors_;
+
+    /**
+     * Offset of each row in 'penalties_', such that the index of a pair
+     * 'c1 < c2' is 'row_offsets_[c1] + c2'.
+     */
+    std::vector<std::ptrdiff_t> row_offsets_;
+
+    /** Flat triangular penalty table. */
+    std::vector<PenaltySum> penalties_;
+
+    /**
+     * Number of neighbors of each color registered with 'add_neighbor',
+     * shifted by one so that uncolored neighbors are counted at index 0.
+     */
+    std::vector<VertexId> neighbor_counts_;
+
+};
+
+/**
+ * Find the pairs of used colors with minimum color pair penalty.
+ *
+ * The pairs are enumerated in the order of the colors of the solution.
+ */
+void local_search_row_weighting_best_color_pairs(
+        const Solution& solution,
+        const ColorPairPenalties& color_pair_penalties,
+        std::vector<std::pair<ColorId, ColorId>>& ccolor_id_bests)
+{
+    ccolor_id_bests.clear();
+    PenaltySum penalty_best = -1;
+    for (auto it_1 = solution.colors_begin();
+            it_1 != solution.colors_end();
+            ++it_1) {
+        for (auto it_2 = std::next(it_1);
+                it_2 != solution.colors_end();
+                ++it_2) {
+            PenaltySum penalty = color_pair_penalties.penalty(*it_1, *it_2);
+            if (ccolor_id_bests.empty() || penalty_best > penalty) {
+                ccolor_id_bests.clear();
+                ccolor_id_bests.push_back({*it_1, *it_2});
+                penalty_best = penalty;
+            } else if (penalty_best == penalty) {
+                ccolor_id_bests.push_back({*it_1, *it_2});
+            }
+        }
+    }
+}
+
+/**
+ * Get the number of colors of the best solution found by the local searches
+ * of the portfolio.
+ */
+inline ColorId local_search_row_weighting_shared_number_of_colors(
+        const std::atomic<ColorId>* shared_number_of_colors)
+{
+    if (shared_number_of_colors == nullptr)
+        return std::numeric_limits<ColorId>::max();
+    return shared_number_of_colors->load();
+}
+
+/**
+ * Publish the number of colors of a feasible solution to the local searches
+ * of the portfolio.
+ */
+inline void local_search_row_weighting_publish(
+        std::atomic<ColorId>* shared_number_of_colors,
+        ColorId number_of_colors)
+{
+    if (shared_number_of_colors == nullptr)
+        return;
+    ColorId number_of_colors_cur = shared_number_of_colors->load();
+    while (number_of_colors < number_of_colors_cur
+            && !shared_number_of_colors->compare_exchange_weak(
+                number_of_colors_cur,
+                number_of_colors)) { }
+}
+
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /////////////////////////// localsearch_rowweighting ///////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -15,55 +357,186 @@ struct LocalSearchRowWeightingVertex
     Counter timestamp = -1;
 };
 
-const LocalSearchRowWeightingOutput coloringsolver::local_search_row_weighting(
-        const Instance& instance,
-        std::mt19937_64& generator,
-        const LocalSearchRowWeightingParameters& parameters)
+namespace
 {
-    LocalSearchRowWeightingOutput output(instance);
-    AlgorithmFormatter algorithm_formatter(parameters, output);
-    algorithm_formatter.start("Row weighting local search");
-    algorithm_formatter.print_header();
 
-    if (instance.adjacency_list_graph() == nullptr) {
-        throw std::runtime_error(
-                "The 'localsearch_rowweighting' algorithm requires an AdjacencyListGraph.");
+/**
+ * Compute the adjacent color penalties and the color pair penalties from
+ * scratch, the penalty of a neighbor being the penalty of the edge linking it
+ * to the vertex.
+ */
+void local_search_row_weighting_compute_penalties(
+        const optimizationtools::AdjacencyListGraph& graph,
+        const Solution& solution,
+        const std::vector<Penalty>& solution_penalties,
+        AdjacentColorPenalties& adjacent_color_penalties,
+        ColorPairPenalties& color_pair_penalties)
+{
+    adjacent_color_penalties.clear();
+    color_pair_penalties.clear();
+    for (EdgeId edge_id = 0;
+            edge_id < graph.number_of_edges();
+            ++edge_id) {
+        VertexId vertex_id_1 = graph.first_end(edge_id);
+        VertexId vertex_id_2 = graph.second_end(edge_id);
+        color_pair_penalties.add(
+                solution.color(vertex_id_1),
+                solution.color(vertex_id_2),
+                solution_penalties[edge_id]);
+        if (solution.contains(vertex_id_2)) {
+            adjacent_color_penalties.add(
+                    vertex_id_1,
+                    solution.color(vertex_id_2),
+                    solution_penalties[edge_id]);
+        }
+        if (solution.contains(vertex_id_1)) {
+            adjacent_color_penalties.add(
+                    vertex_id_2,
+                    solution.color(vertex_id_1),
+                    solution_penalties[edge_id]);
+        }
     }
-    const optimizationtools::AdjacencyListGraph& graph = *instance.adjacency_list_graph();
-
-    // Get initial solution.
-    Parameters greedy_parameters;
-    greedy_parameters.verbosity_level = 0;
-    Solution solution = (parameters.initial_solution != nullptr)?
-        *parameters.initial_solution:
-        greedy_dsatur(instance, greedy_parameters).solution;
+}
 
-    std::stringstream ss;
-    ss << "initial solution";
-    algorithm_formatter.update_solution(solution, ss.str());
-    if (output.solution.number_of_colors() <= parameters.goal) {
-        algorithm_formatter.end();
-        return output;
-    }
-    if (output.solution.number_of_colors() == 1) {
-        algorithm_formatter.end();
-        return output;
+/**
+ * Compute, for each vertex, the sum of the penalties of its edges.
+ */
+void local_search_row_weighting_compute_penalty_sums(
+        const optimizationtools::AdjacencyListGraph& graph,
+        const std::vector<Penalty>& solution_penalties,
+        std::vector<PenaltySum>& penalty_sums)
+{
+    std::fill(penalty_sums.begin(), penalty_sums.end(), 0);
+    for (EdgeId edge_id = 0;
+            edge_id < graph.number_of_edges();
+            ++edge_id) {
+        penalty_sums[graph.first_end(edge_id)] += solution_penalties[edge_id];
+        penalty_sums[graph.second_end(edge_id)] += solution_penalties[edge_id];
     }
+}
+
+/**
+ * Call 'function(vertex_id_neighbor, edge_id)' for each edge of a vertex of
+ * the compact graph.
+ */
+template <typename Function>
+inline void local_search_row_weighting_for_each_edge(
+        const CompactGraph& graph,
+        VertexId vertex_id,
+        Function function)
+{
+    const CompactVertexId* neighbors = graph.neighbors_begin(vertex_id);
+    const CompactEdgeId* edges = graph.edges_begin(vertex_id);
+    for (VertexId pos = 0; pos < graph.degree(vertex_id); ++pos)
+        function(neighbors[pos], edges[pos]);
+}
+
+/**
+ * Call 'function(vertex_id_neighbor, edge_id)' for each edge of a vertex of
+ * the adjacency list graph.
+ */
+template <typename Function>
+inline void local_search_row_weighting_for_each_edge(
+        const optimizationtools::AdjacencyListGraph& graph,
+        VertexId vertex_id,
+        Function function)
+{
+    for (const auto& edge: graph.edges(vertex_id))
+        function(edge.vertex_id, edge.edge_id);
+}
+
+/**
+ * Set the color of a vertex and update the adjacent color penalties of its
+ * neighbors and the color pair penalties.
+ */
+template <typename Graph>
+void local_search_row_weighting_set(
+        const Graph& graph,
+        const std::vector<Penalty>& solution_penalties,
+        AdjacentColorPenalties& adjacent_color_penalties,
+        ColorPairPenalties& color_pair_penalties,
+        Solution& solution,
+        VertexId vertex_id,
+        ColorId color_id)
+{
+    ColorId color_id_old = (solution.contains(vertex_id))?
+        solution.color(vertex_id): -1;
+    if (color_id_old == color_id)
+        return;
+    color_pair_penalties.move(
+            color_id_old,
+            color_id,
+            adjacent_color_penalties.row(vertex_id));
+    local_search_row_weighting_for_each_edge(
+            graph,
+            vertex_id,
+            [&](VertexId vertex_id_neighbor, EdgeId edge_id)
+            {
+                adjacent_color_penalties.move(
+                        vertex_id_neighbor,
+                        color_id_old,
+                        solution_penalties[edge_id],
+                        color_id,
+                        solution_penalties[edge_id]);
+            });
+    solution.set(vertex_id, color_id);
+}
+
+/**
+ * Run the local search from an initial solution.
+ *
+ * The function is templated on the type of the graph used for the neighbor
+ * loops, so that they use the compact graph of the instance when it is
+ * available.
+ */
+template <typename Graph>
+void local_search_row_weighting_run(
+        const Instance& instance,
+        const optimizationtools::AdjacencyListGraph& adjacency_list_graph,
+        const Graph& graph,
+        std::mt19937_64& generator,
+        const LocalSearchRowWeightingParameters& parameters,
+        Solution& solution,
+        LocalSearchRowWeightingOutput& output,
+        AlgorithmFormatter& algorithm_formatter)
+{
+    ColorId goal = std::max(parameters.goal, output.bound);
 
     // Initialize local search structures.
-    std::vector<LocalSearchRowWeightingVertex> vertices(graph.number_of_vertices());
+    std::vector<LocalSearchRowWeightingVertex> vertices(adjacency_list_graph.number_of_vertices());
     Counter number_of_iterations_without_improvement = 0;
     Counter number_of_improvements = 0;
-    std::vector<Penalty> penalties(graph.highest_degree() + 1, 0);
-    std::vector<Penalty> solution_penalties(graph.number_of_edges(), 1);
+    std::vector<Penalty> solution_penalties(adjacency_list_graph.number_of_edges(), 1);
+    // The penalties are stored multiplied by 'penalty_increment', which is
+    // doubled instead of halving all of them.
+    Penalty penalty_increment = 1;
+    std::vector<PenaltySum> penalty_sums(adjacency_list_graph.number_of_vertices());
+    local_search_row_weighting_compute_penalty_sums(
+            adjacency_list_graph,
+            solution_penalties,
+            penalty_sums);
     std::vector<std::pair<VertexId, ColorId>> vcolor_id_bests;
     std::vector<std::pair<ColorId, ColorId>> ccolor_id_bests;
 
     // Structures for the core.
-    std::vector<VertexId> removed_vertices;
+    // The vertices removed by the core reduction are the first vertices of
+    // the degeneracy ordering of the instance.
+    VertexPos number_of_removed_vertices = 0;
     ColorId k = solution.number_of_colors();
     optimizationtools::IndexedSet colors(solution.number_of_colors());
     colors.fill();
+    ColorAvailability color_availability(solution.number_of_colors());
+
+    AdjacentColorPenalties adjacent_color_penalties(
+            adjacency_list_graph.number_of_vertices(),
+            solution.number_of_colors());
+    ColorPairPenalties color_pair_penalties(solution.number_of_colors());
+    local_search_row_weighting_compute_penalties(
+            adjacency_list_graph,
+            solution,
+            solution_penalties,
+            adjacent_color_penalties,
+            color_pair_penalties);
 
     for (output.number_of_iterations = 0;
             !parameters.timer.needs_to_end();
@@ -79,7 +552,10 @@ const LocalSearchRowWeightingOutput coloringsolver::local_search_row_weighting(
         if (parameters.maximum_number_of_improvements != -1
                 && number_of_improvements >= parameters.maximum_number_of_improvements)
             break;
-        if (output.solution.number_of_colors() <= parameters.goal)
+        if (output.solution.number_of_colors() <= goal)
+            break;
+        if (local_search_row_weighting_shared_number_of_colors(
+                    parameters.shared_number_of_colors) <= goal)
             break;
         //if (iterations % 10000 == 0)
         //    std::cout << "it " << iterations << std::endl;
@@ -87,12 +563,19 @@ const LocalSearchRowWeightingOutput coloringsolver::local_search_row_weighting(
         // If the solution is feasible, we merge two colors.
         // We choose the two merged colors to minimize the penalty of the new
         // solution.
-        while (solution.number_of_conflicts() == 0) {
+        // If another local search of the portfolio has already found a
+        // solution with as many colors, we merge two colors as well.
+        while (solution.number_of_conflicts() == 0
+                || (k > 2 && k >= local_search_row_weighting_shared_number_of_colors(
+                        parameters.shared_number_of_colors))) {
+            bool feasible = (solution.number_of_conflicts() == 0);
+
             // Give a color to vertices outside of the core.
-            for (auto it_v = removed_vertices.rbegin();
-                    it_v != removed_vertices.rend(); ++it_v) {
-                VertexId vertex_id = *it_v;
-                optimizationtools::IndexedSet available_colors = colors;
+            for (VertexPos vertex_pos = number_of_removed_vertices - 1;
+                    vertex_pos >= 0;
+                    --vertex_pos) {
+                VertexId vertex_id = instance.degeneracy_ordering()[vertex_pos];
+                color_availability.clear();
                 auto it = graph.neighbors_begin(vertex_id);
                 auto it_end = graph.neighbors_end(vertex_id);
                 for (; it != it_end; ++it) {
@@ -100,145 +583,114 @@ const LocalSearchRowWeightingOutput coloringsolver::local_search_row_weighting(
                     if (solution.contains(vertex_id_neighbor) == 0)
                         continue;
                     ColorId color_id = solution.color(vertex_id_neighbor);
-                    available_colors.remove(color_id);
+                    color_availability.forbid(color_id);
                 }
-                if (available_colors.empty()) {
+                ColorId color_id = color_availability.first_available(
+                        colors.begin(),
+                        colors.end());
+                if (color_id == -1) {
                     throw std::runtime_error(
                             "No available color for vertex "
                             + std::to_string(vertex_id)
                             + ".");
                 }
-                ColorId color_id = *(available_colors.begin());
-                solution.set(vertex_id, color_id);
+                local_search_row_weighting_set(
+                        graph,
+                        solution_penalties,
+                        adjacent_color_penalties,
+                        color_pair_penalties,
+                        solution,
+                        vertex_id,
+                        color_id);
             }
-            if (solution.number_of_conflicts() != 0) {
-                throw std::runtime_error("Solution has conflicts.");
-            }
-
-            // Update best solution
-            if (output.solution.number_of_colors() > solution.number_of_colors()) {
-                std::stringstream ss;
-                ss << "iteration " << output.number_of_iterations;
-                algorithm_formatter.update_solution(solution, ss.str());
-                number_of_improvements++;
-            }
-
-            // Update statistics
-            number_of_iterations_without_improvement = 0;
-
-            // Compute positions.
-            std::vector<ColorPos> positions(graph.highest_degree() + 1, -1);
-            for (ColorPos color_pos = 0; color_pos < solution.number_of_colors(); ++color_pos) {
-                ColorId color_id = *(solution.colors_begin() + color_pos);
-                positions[color_id] = color_pos;
-            }
-
-            // Initialize penalty structure.
-            std::vector<std::vector<Penalty>> penalties(solution.number_of_colors());
-            for (ColorPos color_pos = 0;
-                    color_pos < solution.number_of_colors();
-                    ++color_pos) {
-                penalties[color_pos].resize(
-                        solution.number_of_colors() - color_pos - 1);
-            }
-
-            // Compute penalties.
-            for (EdgeId edge_id = 0;
-                    edge_id < graph.number_of_edges();
-                    ++edge_id) {
-                VertexId vertex_id_1 = graph.first_end(edge_id);
-                VertexId vertex_id_2 = graph.second_end(edge_id);
-                ColorId color_id_1 = solution.color(vertex_id_1);
-                ColorId color_id_2 = solution.color(vertex_id_2);
-                ColorPos color_pos_1 = positions[color_id_1];
-                ColorPos color_pos_2 = positions[color_id_2];
-                ColorPos i1 = std::min(color_pos_1, color_pos_2);
-                ColorPos i2 = std::max(color_pos_1, color_pos_2) - i1 - 1;
-                if (color_id_1 == color_id_2) {
-                    throw std::runtime_error(
-                            "Vertex " + std::to_string(vertex_id_1)
-                            + " and its neighbor vertex "
-                            + std::to_string(vertex_id_2)
-                            + " have the same color "
-                            + std::to_string(color_id_1));
+            if (feasible) {
+                if (solution.number_of_conflicts() != 0) {
+                    throw std::runtime_error("Solution has conflicts.");
                 }
-                if (std::numeric_limits<Penalty>::max()
-                        - solution_penalties[edge_id]
-                        > penalties[i1][i2]) {
-                    penalties[i1][i2] += solution_penalties[edge_id];
-                } else {
-                    penalties[i1][i2] = std::numeric_limits<Penalty>::max();
+
+                // Update best solution
+                if (output.solution.number_of_colors() > solution.number_of_colors()) {
+                    std::stringstream ss;
+                    ss << "iteration " << output.number_of_iterations;
+                    algorithm_formatter.update_solution(solution, ss.str());
+                    number_of_improvements++;
                 }
+                local_search_row_weighting_publish(
+                        parameters.shared_number_of_colors,
+                        solution.number_of_colors());
+
+                // Update statistics
+                number_of_iterations_without_improvement = 0;
             }
 
             // Find best color combination.
-            ccolor_id_bests.clear();
-            Penalty penalty_best = -1;
-            for (ColorPos color_pos_1 = 0; color_pos_1 < solution.number_of_colors(); ++color_pos_1) {
-                for (ColorPos color_pos_2 = color_pos_1 + 1; color_pos_2 < solution.number_of_colors(); ++color_pos_2) {
-                    if (ccolor_id_bests.empty() || penalty_best > penalties[color_pos_1][color_pos_2 - color_pos_1 - 1]) {
-                        ccolor_id_bests.clear();
-                        ccolor_id_bests.push_back({color_pos_1, color_pos_2});
-                        penalty_best = penalties[color_pos_1][color_pos_2 - color_pos_1 - 1];
-                    } else if (!ccolor_id_bests.empty() && penalty_best == penalties[color_pos_1][color_pos_2 - color_pos_1 - 1]) {
-                        ccolor_id_bests.push_back({color_pos_1, color_pos_2});
-                    }
-                }
-            }
+            local_search_row_weighting_best_color_pairs(
+                    solution,
+                    color_pair_penalties,
+                    ccolor_id_bests);
 
             // Apply color merge.
             std::uniform_int_distribution<EdgeId> d_cc(0, ccolor_id_bests.size() - 1);
             auto cc = ccolor_id_bests[d_cc(generator)];
-            ColorId color_id_1_best = *(solution.colors_begin() + cc.first);
-            ColorId color_id_2_best = *(solution.colors_begin() + cc.second);
+            ColorId color_id_1_best = cc.first;
+            ColorId color_id_2_best = cc.second;
             for (VertexId vertex_id = 0;
-                    vertex_id < graph.number_of_vertices();
+                    vertex_id < adjacency_list_graph.number_of_vertices();
                     ++vertex_id)
                 if (solution.color(vertex_id) == color_id_2_best)
-                    solution.set(vertex_id, color_id_1_best);
+                    local_search_row_weighting_set(
+                            graph,
+                            solution_penalties,
+                            adjacent_color_penalties,
+                            color_pair_penalties,
+                            solution,
+                            vertex_id,
+                            color_id_1_best);
             colors.remove(color_id_2_best);
 
             // Compute core.
             k--;
             if (parameters.enable_core_reduction) {
-                removed_vertices = instance.compute_core(k);
-                for (VertexId v: removed_vertices)
-                    solution.set(v, -1);
+                number_of_removed_vertices = instance.number_of_core_removed_vertices(k);
+                for (VertexPos vertex_pos = 0;
+                        vertex_pos < number_of_removed_vertices;
+                        ++vertex_pos) {
+                    local_search_row_weighting_set(
+                            graph,
+                            solution_penalties,
+                            adjacent_color_penalties,
+                            color_pair_penalties,
+                            solution,
+                            instance.degeneracy_ordering()[vertex_pos],
+                            -1);
+                }
             }
 
             if (output.solution.number_of_colors() == 2
                     && !solution.feasible()) {
-                algorithm_formatter.end();
-                return output;
+                return;
             }
         }
 
         // Draw randomly a conflicting edge.
-        std::uniform_int_distribution<EdgeId> d_e(0, solution.number_of_conflicts() - 1);
-        EdgeId edge_id_cur = *std::next(solution.conflicts().begin(), d_e(generator));
+        std::uniform_int_distribution<EdgePos> d_e(0, solution.number_of_conflicts() - 1);
+        EdgeId edge_id_cur = solution.conflict(d_e(generator));
 
         // Find the best swap move.
         vcolor_id_bests.clear();
-        Penalty penalty_best = -1;
-        for (VertexId vertex_id: {graph.first_end(edge_id_cur), graph.second_end(edge_id_cur)}) {
-            for (ColorId color_id: colors)
-                penalties[color_id] = 0;
-            for (const auto& edge: graph.edges(vertex_id)) {
-                if (solution.contains(edge.vertex_id)) {
-                    penalties[solution.color(edge.vertex_id)]
-                        += solution_penalties[edge.edge_id];
-                }
-            }
+        PenaltySum penalty_best = -1;
+        for (VertexId vertex_id: {adjacency_list_graph.first_end(edge_id_cur), adjacency_list_graph.second_end(edge_id_cur)}) {
             for (ColorId color_id: colors) {
                 if (color_id == solution.color(vertex_id))
                     continue;
+                PenaltySum penalty = adjacent_color_penalties.penalty(vertex_id, color_id);
                 if (vcolor_id_bests.empty()
-                        || penalty_best > penalties[color_id]) {
+                        || penalty_best > penalty) {
                     vcolor_id_bests.clear();
                     vcolor_id_bests.push_back({vertex_id, color_id});
-                    penalty_best = penalties[color_id];
+                    penalty_best = penalty;
                 } else if (!vcolor_id_bests.empty()
-                        && penalty_best == penalties[color_id]) {
+                        && penalty_best == penalty) {
                     vcolor_id_bests.push_back({vertex_id, color_id});
                 }
             }
@@ -247,60 +699,157 @@ const LocalSearchRowWeightingOutput coloringsolver::local_search_row_weighting(
         auto vc = vcolor_id_bests[d_vc(generator)];
         // Update vertices structure.
         vertices[vc.first].timestamp = output.number_of_iterations;
+        // The penalties of up to all the edges of the vertex are increased.
+        // Rescale them before if its row could overflow.
+        if (penalty_sums[vc.first]
+                + (PenaltySum)graph.degree(vc.first) * penalty_increment
+                > std::numeric_limits<Penalty>::max()) {
+            local_search_row_weighting_rescale(
+                    solution_penalties,
+                    penalty_increment);
+            local_search_row_weighting_compute_penalty_sums(
+                    adjacency_list_graph,
+                    solution_penalties,
+                    penalty_sums);
+            local_search_row_weighting_compute_penalties(
+                    adjacency_list_graph,
+                    solution,
+                    solution_penalties,
+                    adjacent_color_penalties,
+                    color_pair_penalties);
+        }
         // Update penalties.
-        bool reduce = false;
+        // The adjacent color penalties of the neighbors are updated during the
+        // same scan.
+        // The color pair penalties are updated before, since the edges which
+        // get penalized become conflicting and are not counted anymore.
+        bool decay = false;
+        bool rescale = false;
+        ColorId color_id_old = solution.color(vc.first);
+        color_pair_penalties.move(
+                color_id_old,
+                vc.second,
+                adjacent_color_penalties.row(vc.first));
+        local_search_row_weighting_for_each_edge(
+                graph,
+                vc.first,
+                [&](VertexId vertex_id_neighbor, EdgeId edge_id)
+                {
+                    Penalty& penalty = solution_penalties[edge_id];
+                    Penalty penalty_old = penalty;
+                    if (solution.color(vertex_id_neighbor) == vc.second) {
+                        penalty += penalty_increment;
+                        adjacent_color_penalties.add(vc.first, vc.second, penalty_increment);
+                        penalty_sums[vc.first] += penalty_increment;
+                        penalty_sums[vertex_id_neighbor] += penalty_increment;
+                        if (penalty_sums[vertex_id_neighbor]
+                                > local_search_row_weighting_maximum_penalty)
+                            rescale = true;
+                        if (local_search_row_weighting_decay(
+                                    penalty,
+                                    penalty_increment,
+                                    parameters.penalty_decay_threshold))
+                            decay = true;
+                    }
+                    adjacent_color_penalties.move(
+                            vertex_id_neighbor,
+                            color_id_old,
+                            penalty_old,
+                            vc.second,
+                            penalty);
+                });
+        // Update solution.
+        solution.set(vc.first, vc.second);
+        // Halving all the penalties is the same as doubling the increment.
+        if (decay)
+            penalty_increment *= 2;
+        if (penalty_sums[vc.first] > local_search_row_weighting_maximum_penalty
+                || penalty_increment > local_search_row_weighting_maximum_penalty_increment)
+            rescale = true;
+        if (rescale) {
+            local_search_row_weighting_rescale(
+                    solution_penalties,
+                    penalty_increment);
+            local_search_row_weighting_compute_penalty_sums(
+                    adjacency_list_graph,
+                    solution_penalties,
+                    penalty_sums);
+            local_search_row_weighting_compute_penalties(
+                    adjacency_list_graph,
+                    solution,
+                    solution_penalties,
+                    adjacent_color_penalties,
+                    color_pair_penalties);
+        }
 
-        for (const auto& edge: graph.edges(vc.first)) {
-            if (solution.color(edge.vertex_id) == vc.second) {
-                solution_penalties[edge.edge_id]++;
-                if (solution_penalties[edge.edge_id] > std::numeric_limits<Penalty>::max() / 2)
-                    reduce = true;
+        if (parameters.check_penalties) {
+            AdjacentColorPenalties adjacent_color_penalties_check(
+                    adjacency_list_graph.number_of_vertices(),
+                    adjacent_color_penalties.number_of_colors());
+            ColorPairPenalties color_pair_penalties_check(
+                    adjacent_color_penalties.number_of_colors());
+            local_search_row_weighting_compute_penalties(
+                    adjacency_list_graph,
+                    solution,
+                    solution_penalties,
+                    adjacent_color_penalties_check,
+                    color_pair_penalties_check);
+            if (!(adjacent_color_penalties_check == adjacent_color_penalties)) {
+                throw std::runtime_error(
+                        "Adjacent color penalties differ from their"
+                        " computation from scratch at iteration "
+                        + std::to_string(output.number_of_iterations) + ".");
             }
-        }
-        if (reduce) {
-            //std::cout << "reduce" << std::endl;
-            for (EdgeId edge_id = 0;
-                    edge_id < graph.number_of_edges();
-                    ++edge_id) {
-                solution_penalties[edge_id] = (solution_penalties[edge_id] - 1) / 2 + 1;
+            if (!(color_pair_penalties_check == color_pair_penalties)) {
+                throw std::runtime_error(
+                        "Color pair penalties differ from their"
+                        " computation from scratch at iteration "
+                        + std::to_string(output.number_of_iterations) + ".");
             }
         }
-        // Update solution.
-        solution.set(vc.first, vc.second);
     }
 
-    algorithm_formatter.end();
-    return output;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-////////////////////////// localsearch_rowweighting_2 //////////////////////////
-////////////////////////////////////////////////////////////////////////////////
+}
 
-const LocalSearchRowWeighting2Output coloringsolver::local_search_row_weighting_2(
+const LocalSearchRowWeightingOutput coloringsolver::local_search_row_weighting(
         const Instance& instance,
         std::mt19937_64& generator,
-        const LocalSearchRowWeighting2Parameters& parameters)
+        const LocalSearchRowWeightingParameters& parameters)
 {
-    LocalSearchRowWeighting2Output output(instance);
+    LocalSearchRowWeightingOutput output(instance);
     AlgorithmFormatter algorithm_formatter(parameters, output);
-    algorithm_formatter.start("Row weighting local search 2");
+    algorithm_formatter.start("Row weighting local search");
     algorithm_formatter.print_header();
+    algorithm_formatter.update_clique_bound();
+    // Stop as soon as the solution is optimal.
+    ColorId goal = std::max(parameters.goal, output.bound);
 
-    const optimizationtools::AbstractGraph& graph = instance.graph();
+    if (instance.adjacency_list_graph() == nullptr) {
+        throw std::runtime_error(
+                "The 'localsearch_rowweighting' algorithm requires an AdjacencyListGraph.");
+    }
+    const optimizationtools::AdjacencyListGraph& graph = *instance.adjacency_list_graph();
 
-    // Compute initial greedy solution.
     // Get initial solution.
-    Parameters greedy_parameters;
+    GreedyDsaturParameters greedy_parameters;
     greedy_parameters.verbosity_level = 0;
+    // The initial solution may be partial or infeasible; it is repaired
+    // first, which also makes its colors consecutive.
     Solution solution = (parameters.initial_solution != nullptr)?
-        *parameters.initial_solution:
+        greedy_repair(*parameters.initial_solution, greedy_parameters).solution:
         greedy_dsatur(instance, greedy_parameters).solution;
 
     std::stringstream ss;
     ss << "initial solution";
     algorithm_formatter.update_solution(solution, ss.str());
-    if (output.solution.number_of_colors() <= parameters.goal) {
+    if (solution.feasible()) {
+        local_search_row_weighting_publish(
+                parameters.shared_number_of_colors,
+                solution.number_of_colors());
+    }
+    if (output.solution.number_of_colors() <= goal) {
         algorithm_formatter.end();
         return output;
     }
@@ -309,20 +858,196 @@ const LocalSearchRowWeighting2Output coloringsolver::local_search_row_weighting_
         return output;
     }
 
+    if (instance.compact_graph() != nullptr) {
+        local_search_row_weighting_run(
+                instance,
+                graph,
+                *instance.compact_graph(),
+                generator,
+                parameters,
+                solution,
+                output,
+                algorithm_formatter);
+    } else {
+        local_search_row_weighting_run(
+                instance,
+                graph,
+                graph,
+                generator,
+                parameters,
+                solution,
+                output,
+                algorithm_formatter);
+    }
+
+    algorithm_formatter.end();
+    return output;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////// localsearch_rowweighting_2 //////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+/**
+ * Compute the adjacent color penalties and the color pair penalties from
+ * scratch.
+ *
+ * The penalty of a neighbor is its vertex penalty and the penalty of an edge
+ * is the sum of the penalties of its ends.
+ */
+template <typename Graph>
+void local_search_row_weighting_2_compute_penalties(
+        const Graph& graph,
+        const Solution& solution,
+        const std::vector<Penalty>& vertex_penalties,
+        AdjacentColorPenalties& adjacent_color_penalties,
+        ColorPairPenalties& color_pair_penalties)
+{
+    adjacent_color_penalties.clear();
+    color_pair_penalties.clear();
+    for (VertexId vertex_id = 0;
+            vertex_id < graph.number_of_vertices();
+            ++vertex_id) {
+        if (!solution.contains(vertex_id))
+            continue;
+        ColorId color_id = solution.color(vertex_id);
+        auto it = graph.neighbors_begin(vertex_id);
+        auto it_end = graph.neighbors_end(vertex_id);
+        for (; it != it_end; ++it) {
+            VertexId vertex_id_neighbor = *it;
+            adjacent_color_penalties.add(
+                    vertex_id_neighbor,
+                    color_id,
+                    vertex_penalties[vertex_id]);
+            if (vertex_id_neighbor < vertex_id) {
+                color_pair_penalties.add(
+                        color_id,
+                        solution.color(vertex_id_neighbor),
+                        (PenaltySum)vertex_penalties[vertex_id]
+                        + vertex_penalties[vertex_id_neighbor]);
+            }
+        }
+    }
+}
+
+/**
+ * Compute, for each vertex, the sum of the penalties of its neighbors.
+ */
+template <typename Graph>
+void local_search_row_weighting_2_compute_penalty_sums(
+        const Graph& graph,
+        const std::vector<Penalty>& vertex_penalties,
+        std::vector<PenaltySum>& penalty_sums)
+{
+    for (VertexId vertex_id = 0;
+            vertex_id < graph.number_of_vertices();
+            ++vertex_id) {
+        penalty_sums[vertex_id] = 0;
+        auto it = graph.neighbors_begin(vertex_id);
+        auto it_end = graph.neighbors_end(vertex_id);
+        for (; it != it_end; ++it)
+            penalty_sums[vertex_id] += vertex_penalties[*it];
+    }
+}
+
+/**
+ * Set the color of a vertex and update the adjacent color penalties of its
+ * neighbors and the color pair penalties.
+ *
+ * 'check' is forwarded to 'Solution::set'.
+ */
+template <typename Graph>
+void local_search_row_weighting_2_set(
+        const Graph& graph,
+        const std::vector<Penalty>& vertex_penalties,
+        AdjacentColorPenalties& adjacent_color_penalties,
+        ColorPairPenalties& color_pair_penalties,
+        Solution& solution,
+        VertexId vertex_id,
+        ColorId color_id,
+        bool check = true)
+{
+    ColorId color_id_old = (solution.contains(vertex_id))?
+        solution.color(vertex_id): -1;
+    if (color_id_old == color_id)
+        return;
+    auto it = graph.neighbors_begin(vertex_id);
+    auto it_end = graph.neighbors_end(vertex_id);
+    for (; it != it_end; ++it) {
+        VertexId vertex_id_neighbor = *it;
+        adjacent_color_penalties.move(
+                vertex_id_neighbor,
+                color_id_old,
+                vertex_penalties[vertex_id],
+                color_id,
+                vertex_penalties[vertex_id]);
+        color_pair_penalties.add_neighbor(solution.color(vertex_id_neighbor));
+    }
+    // The penalty of an edge is the sum of the penalties of its ends.
+    color_pair_penalties.move(
+            color_id_old,
+            color_id,
+            adjacent_color_penalties.row(vertex_id),
+            vertex_penalties[vertex_id]);
+    solution.set(vertex_id, color_id, check);
+}
+
+/**
+ * Run the local search from an initial solution.
+ *
+ * The function is templated on the type of the graph, so that the neighbor
+ * loops use the compact graph of the instance when it is available.
+ */
+template <typename Graph>
+void local_search_row_weighting_2_run(
+        const Instance& instance,
+        const Graph& graph,
+        std::mt19937_64& generator,
+        const LocalSearchRowWeighting2Parameters& parameters,
+        Solution& solution,
+        LocalSearchRowWeighting2Output& output,
+        AlgorithmFormatter& algorithm_formatter)
+{
+    ColorId goal = std::max(parameters.goal, output.bound);
+
     // Initialize local search structures.
     Counter number_of_iterations_without_improvement = 0;
     Counter number_of_improvements = 0;
-    std::vector<Penalty> penalties(graph.highest_degree() + 1, 0);
     std::vector<Penalty> vertex_penalties(graph.number_of_vertices(), 1);
+    // The penalties are stored multiplied by 'penalty_increment', which is
+    // doubled instead of halving all of them.
+    Penalty penalty_increment = 1;
+    std::vector<PenaltySum> penalty_sums(graph.number_of_vertices());
+    local_search_row_weighting_2_compute_penalty_sums(
+            graph,
+            vertex_penalties,
+            penalty_sums);
     optimizationtools::IndexedSet uncolored_vertices(graph.number_of_vertices());
     std::vector<std::pair<ColorId, ColorId>> ccolor_id_bests;
     std::vector<ColorId> color_id_bests;
 
     // Structures for the core.
-    std::vector<VertexId> removed_vertices;
+    // The vertices removed by the core reduction are the first vertices of
+    // the degeneracy ordering of the instance.
+    VertexPos number_of_removed_vertices = 0;
     ColorId k = solution.number_of_colors();
     optimizationtools::IndexedSet colors(solution.number_of_colors());
     colors.fill();
+    ColorAvailability color_availability(solution.number_of_colors());
+
+    AdjacentColorPenalties adjacent_color_penalties(
+            graph.number_of_vertices(),
+            solution.number_of_colors());
+    ColorPairPenalties color_pair_penalties(solution.number_of_colors());
+    local_search_row_weighting_2_compute_penalties(
+            graph,
+            solution,
+            vertex_penalties,
+            adjacent_color_penalties,
+            color_pair_penalties);
 
     for (output.number_of_iterations = 0;
             !parameters.timer.needs_to_end();
@@ -338,7 +1063,10 @@ const LocalSearchRowWeighting2Output coloringsolver::local_search_row_weighting_
         if (parameters.maximum_number_of_improvements != -1
                 && number_of_improvements >= parameters.maximum_number_of_improvements)
             break;
-        if (output.solution.number_of_colors() <= parameters.goal)
+        if (output.solution.number_of_colors() <= goal)
+            break;
+        if (local_search_row_weighting_shared_number_of_colors(
+                    parameters.shared_number_of_colors) <= goal)
             break;
         //if (iterations % 10000 == 0)
         //    std::cout << "it " << iterations << std::endl;
@@ -346,12 +1074,19 @@ const LocalSearchRowWeighting2Output coloringsolver::local_search_row_weighting_
         // If the solution is feasible, we merge two colors.
         // We choose the two merged colors to minimize the penalty of the new
         // solution.
-        while (uncolored_vertices.empty()) {
+        // If another local search of the portfolio has already found a
+        // solution with as many colors, we merge two colors as well.
+        while (uncolored_vertices.empty()
+                || (k > 2 && k >= local_search_row_weighting_shared_number_of_colors(
+                        parameters.shared_number_of_colors))) {
+            bool feasible = uncolored_vertices.empty();
+
             // Give a color to vertices outside of the core.
-            for (auto it_v = removed_vertices.rbegin();
-                    it_v != removed_vertices.rend(); ++it_v) {
-                VertexId vertex_id = *it_v;
-                optimizationtools::IndexedSet available_colors = colors;
+            for (VertexPos vertex_pos = number_of_removed_vertices - 1;
+                    vertex_pos >= 0;
+                    --vertex_pos) {
+                VertexId vertex_id = instance.degeneracy_ordering()[vertex_pos];
+                color_availability.clear();
                 auto it = graph.neighbors_begin(vertex_id);
                 auto it_end = graph.neighbors_end(vertex_id);
                 for (; it != it_end; ++it) {
@@ -359,118 +1094,89 @@ const LocalSearchRowWeighting2Output coloringsolver::local_search_row_weighting_
                     if (solution.contains(vertex_id_neighbor) == 0)
                         continue;
                     ColorId color_id = solution.color(vertex_id_neighbor);
-                    available_colors.remove(color_id);
+                    color_availability.forbid(color_id);
                 }
-                if (available_colors.empty()) {
+                ColorId color_id = color_availability.first_available(
+                        colors.begin(),
+                        colors.end());
+                if (color_id == -1) {
                     throw std::runtime_error(
                             "No available color for vertex "
                             + std::to_string(vertex_id)
                             + ".");
                 }
-                ColorId color_id = *(available_colors.begin());
-                solution.set(vertex_id, color_id);
-            }
-            if (solution.number_of_conflicts() != 0) {
-                throw std::runtime_error("Solution has conflicts.");
-            }
-
-            // Update best solution
-            if (output.solution.number_of_colors() > solution.number_of_colors()) {
-                std::stringstream ss;
-                ss << "iteration " << output.number_of_iterations;
-                algorithm_formatter.update_solution(solution, ss.str());
-                number_of_improvements++;
-            }
-
-            // Update statistics
-            number_of_iterations_without_improvement = 0;
-
-            // Compute positions.
-            std::vector<ColorPos> positions(graph.highest_degree() + 1, -1);
-            for (ColorPos color_pos = 0; color_pos < solution.number_of_colors(); ++color_pos) {
-                ColorId color_id = *(solution.colors_begin() + color_pos);
-                positions[color_id] = color_pos;
-            }
-
-            // Initialize penalty structure.
-            std::vector<std::vector<Penalty>> penalties(solution.number_of_colors());
-            for (ColorPos color_pos = 0;
-                    color_pos < solution.number_of_colors();
-                    ++color_pos) {
-                penalties[color_pos].resize(solution.number_of_colors() - color_pos - 1);
+                local_search_row_weighting_2_set(
+                        graph,
+                        vertex_penalties,
+                        adjacent_color_penalties,
+                        color_pair_penalties,
+                        solution,
+                        vertex_id,
+                        color_id);
             }
+            if (feasible) {
+                if (solution.number_of_conflicts() != 0) {
+                    throw std::runtime_error("Solution has conflicts.");
+                }
 
-            // Compute penalties.
-            for (VertexId vertex_id_1 = 0; vertex_id_1 < graph.number_of_vertices(); ++vertex_id_1) {
-                auto it = graph.neighbors_begin(vertex_id_1);
-                auto it_end = graph.neighbors_end(vertex_id_1);
-                for (; it != it_end; ++it) {
-                    VertexId vertex_id_2 = *it;
-                    if (vertex_id_2 <= vertex_id_1)
-                        continue;
-                    ColorId color_id_1 = solution.color(vertex_id_1);
-                    ColorId color_id_2 = solution.color(vertex_id_2);
-                    ColorPos color_pos_1 = positions[color_id_1];
-                    ColorPos color_pos_2 = positions[color_id_2];
-                    ColorPos i1 = std::min(color_pos_1, color_pos_2);
-                    ColorPos i2 = std::max(color_pos_1, color_pos_2) - i1 - 1;
-                    if (color_id_1 == color_id_2) {
-                        throw std::runtime_error(
-                                "Vertex " + std::to_string(vertex_id_1)
-                                + " and its neighbor vertex "
-                                + std::to_string(vertex_id_2)
-                                + " have the same color "
-                                + std::to_string(color_id_1));
-                    }
-                    if (std::numeric_limits<Penalty>::max()
-                            - vertex_penalties[vertex_id_1] - vertex_penalties[vertex_id_2]
-                            > penalties[i1][i2]) {
-                        penalties[i1][i2] += vertex_penalties[vertex_id_1] + vertex_penalties[vertex_id_2];
-                    } else {
-                        penalties[i1][i2] = std::numeric_limits<Penalty>::max();
-                    }
+                // Update best solution
+                if (output.solution.number_of_colors() > solution.number_of_colors()) {
+                    std::stringstream ss;
+                    ss << "iteration " << output.number_of_iterations;
+                    algorithm_formatter.update_solution(solution, ss.str());
+                    number_of_improvements++;
                 }
+                local_search_row_weighting_publish(
+                        parameters.shared_number_of_colors,
+                        solution.number_of_colors());
+
+                // Update statistics
+                number_of_iterations_without_improvement = 0;
             }
 
             // Find best color combination.
-            ccolor_id_bests.clear();
-            Penalty penalty_best = -1;
-            for (ColorPos color_pos_1 = 0;
-                    color_pos_1 < solution.number_of_colors();
-                    ++color_pos_1) {
-                for (ColorPos color_pos_2 = color_pos_1 + 1;
-                        color_pos_2 < solution.number_of_colors();
-                        ++color_pos_2) {
-                    if (ccolor_id_bests.empty() || penalty_best > penalties[color_pos_1][color_pos_2 - color_pos_1 - 1]) {
-                        ccolor_id_bests.clear();
-                        ccolor_id_bests.push_back({color_pos_1, color_pos_2});
-                        penalty_best = penalties[color_pos_1][color_pos_2 - color_pos_1 - 1];
-                    } else if (!ccolor_id_bests.empty()
-                            && penalty_best == penalties[color_pos_1][color_pos_2 - color_pos_1 - 1]) {
-                        ccolor_id_bests.push_back({color_pos_1, color_pos_2});
-                    }
-                }
-            }
+            local_search_row_weighting_best_color_pairs(
+                    solution,
+                    color_pair_penalties,
+                    ccolor_id_bests);
 
             // Apply color merge.
             std::uniform_int_distribution<EdgeId> d_cc(0, ccolor_id_bests.size() - 1);
             auto cc = ccolor_id_bests[d_cc(generator)];
-            ColorId color_id_1_best = *(solution.colors_begin() + cc.first);
-            ColorId color_id_2_best = *(solution.colors_begin() + cc.second);
+            ColorId color_id_1_best = cc.first;
+            ColorId color_id_2_best = cc.second;
             for (VertexId vertex_id = 0;
                     vertex_id < graph.number_of_vertices();
                     ++vertex_id) {
-                if (solution.color(vertex_id) == color_id_2_best)
-                    solution.set(vertex_id, color_id_1_best);
+                if (solution.color(vertex_id) == color_id_2_best) {
+                    local_search_row_weighting_2_set(
+                            graph,
+                            vertex_penalties,
+                            adjacent_color_penalties,
+                            color_pair_penalties,
+                            solution,
+                            vertex_id,
+                            color_id_1_best);
+                }
             }
             colors.remove(color_id_2_best);
 
             // Compute core.
             k--;
             if (parameters.enable_core_reduction) {
-                removed_vertices = instance.compute_core(k);
-                for (VertexId vertex_id: removed_vertices)
-                    solution.set(vertex_id, -1);
+                number_of_removed_vertices = instance.number_of_core_removed_vertices(k);
+                for (VertexPos vertex_pos = 0;
+                        vertex_pos < number_of_removed_vertices;
+                        ++vertex_pos) {
+                    local_search_row_weighting_2_set(
+                            graph,
+                            vertex_penalties,
+                            adjacent_color_penalties,
+                            color_pair_penalties,
+                            solution,
+                            instance.degeneracy_ordering()[vertex_pos],
+                            -1);
+                }
             }
 
             // Remove conflicting vertices.
@@ -481,15 +1187,21 @@ const LocalSearchRowWeighting2Output coloringsolver::local_search_row_weighting_
             }
             for (VertexId vertex_id: vec) {
                 if (solution.contains(vertex_id)) {
-                    solution.set(vertex_id, -1);
+                    local_search_row_weighting_2_set(
+                            graph,
+                            vertex_penalties,
+                            adjacent_color_penalties,
+                            color_pair_penalties,
+                            solution,
+                            vertex_id,
+                            -1);
                     uncolored_vertices.add(vertex_id);
                 }
             }
 
             if (output.solution.number_of_colors() == 2
                     && !solution.feasible()) {
-                algorithm_formatter.end();
-                return output;
+                return;
             }
         }
 
@@ -499,68 +1211,339 @@ const LocalSearchRowWeighting2Output coloringsolver::local_search_row_weighting_
 
         // Find the best swap move.
         color_id_bests.clear();
-        Penalty penalty_best = -1;
-        for (ColorId color_id: colors)
-            penalties[color_id] = 0;
-        auto it = graph.neighbors_begin(vertex_id_cur);
-        auto it_end = graph.neighbors_end(vertex_id_cur);
-        for (; it != it_end; ++it) {
-            VertexId vertex_id_neighbor = *it;
-            if (solution.contains(vertex_id_neighbor)) {
-                penalties[solution.color(vertex_id_neighbor)]
-                    += vertex_penalties[vertex_id_neighbor];
-            }
-        }
+        PenaltySum penalty_best = -1;
         for (ColorId color_id: colors) {
-            if (color_id_bests.empty() || penalty_best > penalties[color_id]) {
+            PenaltySum penalty = adjacent_color_penalties.penalty(vertex_id_cur, color_id);
+            if (color_id_bests.empty() || penalty_best > penalty) {
                 color_id_bests.clear();
                 color_id_bests.push_back(color_id);
-                penalty_best = penalties[color_id];
+                penalty_best = penalty;
             } else if (!color_id_bests.empty()
-                    && penalty_best == penalties[color_id]) {
+                    && penalty_best == penalty) {
                 color_id_bests.push_back(color_id);
             }
         }
         std::uniform_int_distribution<EdgeId> d_c(0, color_id_bests.size() - 1);
         ColorId color_id_best = color_id_bests[d_c(generator)];
-        // Update penalties.
-        bool reduce = false;
-        it = graph.neighbors_begin(vertex_id_cur);
-        it_end = graph.neighbors_end(vertex_id_cur);
+        // Uncolor the neighbors having the new color of the vertex.
+        // Conflicting vertices are always uncolored, therefore, these changes
+        // of color don't add or remove any conflict.
+        uncolored_vertices.remove(vertex_id_cur);
+        std::vector<VertexId> vertices_to_remove;
+        auto it = graph.neighbors_begin(vertex_id_cur);
+        auto it_end = graph.neighbors_end(vertex_id_cur);
         for (; it != it_end; ++it) {
             VertexId vertex_id_neighbor = *it;
             if (solution.color(vertex_id_neighbor) == color_id_best) {
-                vertex_penalties[vertex_id_neighbor]++;
-                if (vertex_penalties[vertex_id_neighbor]
-                        > std::numeric_limits<Penalty>::max() / 2)
-                    reduce = true;
+                vertices_to_remove.push_back(vertex_id_neighbor);
+                uncolored_vertices.add(vertex_id_neighbor);
             }
         }
-        if (reduce) {
-            //std::cout << "reduce" << std::endl;
-            for (VertexId vertex_id = 0;
-                    vertex_id < graph.number_of_vertices();
-                    ++vertex_id) {
-                vertex_penalties[vertex_id] = (vertex_penalties[vertex_id] - 1) / 2 + 1;
+        for (VertexId vertex_id: vertices_to_remove) {
+            local_search_row_weighting_2_set(
+                    graph,
+                    vertex_penalties,
+                    adjacent_color_penalties,
+                    color_pair_penalties,
+                    solution,
+                    vertex_id,
+                    -1,
+                    false);
+        }
+        // Update penalties.
+        // The penalized vertices have just been uncolored, therefore, the
+        // adjacent color penalties don't need to be updated.
+        bool decay = false;
+        bool rescale = false;
+        for (VertexId vertex_id: vertices_to_remove) {
+            vertex_penalties[vertex_id] += penalty_increment;
+            if (local_search_row_weighting_decay(
+                        vertex_penalties[vertex_id],
+                        penalty_increment,
+                        parameters.penalty_decay_threshold))
+                decay = true;
+            auto it = graph.neighbors_begin(vertex_id);
+            auto it_end = graph.neighbors_end(vertex_id);
+            for (; it != it_end; ++it) {
+                penalty_sums[*it] += penalty_increment;
+                if (penalty_sums[*it] > local_search_row_weighting_maximum_penalty)
+                    rescale = true;
             }
         }
+        // Halving all the penalties is the same as doubling the increment.
+        if (decay)
+            penalty_increment *= 2;
+        if (penalty_increment > local_search_row_weighting_maximum_penalty_increment)
+            rescale = true;
+        if (rescale) {
+            local_search_row_weighting_rescale(
+                    vertex_penalties,
+                    penalty_increment);
+            local_search_row_weighting_2_compute_penalty_sums(
+                    graph,
+                    vertex_penalties,
+                    penalty_sums);
+            local_search_row_weighting_2_compute_penalties(
+                    graph,
+                    solution,
+                    vertex_penalties,
+                    adjacent_color_penalties,
+                    color_pair_penalties);
+        }
         // Update solution.
-        solution.set(vertex_id_cur, color_id_best);
-        uncolored_vertices.remove(vertex_id_cur);
-        std::vector<VertexId> vertices_to_remove;
-        it = graph.neighbors_begin(vertex_id_cur);
-        it_end = graph.neighbors_end(vertex_id_cur);
-        for (; it != it_end; ++it) {
-            VertexId vertex_id_neighbor = *it;
-            if (solution.color(vertex_id_neighbor) == color_id_best) {
-                vertices_to_remove.push_back(vertex_id_neighbor);
-                uncolored_vertices.add(vertex_id_neighbor);
+        local_search_row_weighting_2_set(
+                graph,
+                vertex_penalties,
+                adjacent_color_penalties,
+                color_pair_penalties,
+                solution,
+                vertex_id_cur,
+                color_id_best,
+                false);
+
+        if (parameters.check_penalties) {
+            AdjacentColorPenalties adjacent_color_penalties_check(
+                    graph.number_of_vertices(),
+                    adjacent_color_penalties.number_of_colors());
+            ColorPairPenalties color_pair_penalties_check(
+                    adjacent_color_penalties.number_of_colors());
+            local_search_row_weighting_2_compute_penalties(
+                    graph,
+                    solution,
+                    vertex_penalties,
+                    adjacent_color_penalties_check,
+                    color_pair_penalties_check);
+            if (!(adjacent_color_penalties_check == adjacent_color_penalties)) {
+                throw std::runtime_error(
+                        "Adjacent color penalties differ from their"
+                        " computation from scratch at iteration "
+                        + std::to_string(output.number_of_iterations) + ".");
+            }
+            if (!(color_pair_penalties_check == color_pair_penalties)) {
+                throw std::runtime_error(
+                        "Color pair penalties differ from their"
+                        " computation from scratch at iteration "
+                        + std::to_string(output.number_of_iterations) + ".");
             }
         }
-        for (VertexId vertex_id: vertices_to_remove)
-            solution.set(vertex_id, -1);
     }
 
+}
+
+}
+
+const LocalSearchRowWeighting2Output coloringsolver::local_search_row_weighting_2(
+        const Instance& instance,
+        std::mt19937_64& generator,
+        const LocalSearchRowWeighting2Parameters& parameters)
+{
+    LocalSearchRowWeighting2Output output(instance);
+    AlgorithmFormatter algorithm_formatter(parameters, output);
+    algorithm_formatter.start("Row weighting local search 2");
+    algorithm_formatter.print_header();
+    algorithm_formatter.update_clique_bound();
+    ColorId goal = std::max(parameters.goal, output.bound);
+
+    // Compute initial greedy solution.
+    // Get initial solution.
+    GreedyDsaturParameters greedy_parameters;
+    greedy_parameters.verbosity_level = 0;
+    Solution solution = (parameters.initial_solution != nullptr)?
+        greedy_repair(*parameters.initial_solution, greedy_parameters).solution:
+        greedy_dsatur(instance, greedy_parameters).solution;
+
+    std::stringstream ss;
+    ss << "initial solution";
+    algorithm_formatter.update_solution(solution, ss.str());
+    if (solution.feasible()) {
+        local_search_row_weighting_publish(
+                parameters.shared_number_of_colors,
+                solution.number_of_colors());
+    }
+    if (output.solution.number_of_colors() <= goal) {
+        algorithm_formatter.end();
+        return output;
+    }
+    if (output.solution.number_of_colors() == 1) {
+        algorithm_formatter.end();
+        return output;
+    }
+
+    if (instance.compact_graph() != nullptr) {
+        local_search_row_weighting_2_run(
+                instance,
+                *instance.compact_graph(),
+                generator,
+                parameters,
+                solution,
+                output,
+                algorithm_formatter);
+    } else {
+        local_search_row_weighting_2_run(
+                instance,
+                instance.graph(),
+                generator,
+                parameters,
+                solution,
+                output,
+                algorithm_formatter);
+    }
+
+    algorithm_formatter.end();
+    return output;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////// localsearch_rowweighting_portfolio //////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+/**
+ * Set the parameters of a local search of the portfolio.
+ */
+template <typename LocalSearchParameters>
+void local_search_row_weighting_portfolio_set_parameters(
+        const LocalSearchRowWeightingPortfolioParameters& parameters,
+        ColorId goal,
+        Solution* initial_solution,
+        std::atomic<ColorId>* shared_number_of_colors,
+        const NewSolutionCallback& new_solution_callback,
+        LocalSearchParameters& local_search_parameters)
+{
+    local_search_parameters.verbosity_level = 0;
+    local_search_parameters.clique_lower_bound = false;
+    local_search_parameters.timer = parameters.timer;
+    local_search_parameters.maximum_number_of_iterations
+        = parameters.maximum_number_of_iterations;
+    local_search_parameters.maximum_number_of_iterations_without_improvement
+        = parameters.maximum_number_of_iterations_without_improvement;
+    // The initial solution has more than 2 colors, therefore, the graph has
+    // edges and a solution with 2 colors is optimal.
+    local_search_parameters.goal = std::max(goal, (ColorId)2);
+    local_search_parameters.enable_core_reduction = parameters.enable_core_reduction;
+    local_search_parameters.penalty_decay_threshold = parameters.penalty_decay_threshold;
+    local_search_parameters.initial_solution = initial_solution;
+    local_search_parameters.shared_number_of_colors = shared_number_of_colors;
+    local_search_parameters.new_solution_callback = new_solution_callback;
+}
+
+}
+
+const LocalSearchRowWeightingPortfolioOutput coloringsolver::local_search_row_weighting_portfolio(
+        const Instance& instance,
+        std::mt19937_64& generator,
+        const LocalSearchRowWeightingPortfolioParameters& parameters)
+{
+    LocalSearchRowWeightingPortfolioOutput output(instance);
+    AlgorithmFormatter algorithm_formatter(parameters, output);
+    algorithm_formatter.start("Row weighting local search portfolio");
+    algorithm_formatter.print_header();
+    algorithm_formatter.update_clique_bound();
+    ColorId goal = std::max(parameters.goal, output.bound);
+
+    if (parameters.number_of_threads < 1) {
+        throw std::invalid_argument(
+                "The number of threads must be at least 1.");
+    }
+
+    // Get initial solution.
+    // It is computed once and copied by each local search.
+    GreedyDsaturParameters greedy_parameters;
+    greedy_parameters.verbosity_level = 0;
+    Solution solution = (parameters.initial_solution != nullptr)?
+        greedy_repair(*parameters.initial_solution, greedy_parameters).solution:
+        greedy_dsatur(instance, greedy_parameters).solution;
+
+    std::stringstream ss;
+    ss << "initial solution";
+    algorithm_formatter.update_solution(solution, ss.str());
+    if (output.solution.number_of_colors() <= goal) {
+        algorithm_formatter.end();
+        return output;
+    }
+    // A solution with 2 colors is optimal if the graph has edges.
+    if (output.solution.number_of_colors() <= 2) {
+        algorithm_formatter.end();
+        return output;
+    }
+
+    std::atomic<ColorId> shared_number_of_colors(
+            (solution.feasible())?
+            solution.number_of_colors():
+            std::numeric_limits<ColorId>::max());
+
+    // The local searches report their new best solutions through the
+    // algorithm formatter of the portfolio.
+    std::mutex mutex;
+    std::vector<std::mt19937_64> generators;
+    for (Counter thread_id = 0;
+            thread_id < parameters.number_of_threads;
+            ++thread_id) {
+        generators.emplace_back(generator());
+    }
+    std::vector<Counter> numbers_of_iterations(parameters.number_of_threads, 0);
+    std::vector<std::exception_ptr> exceptions(parameters.number_of_threads);
+
+    std::vector<std::thread> threads;
+    for (Counter thread_id = 0;
+            thread_id < parameters.number_of_threads;
+            ++thread_id) {
+        threads.push_back(std::thread([&, thread_id]()
+        {
+            try {
+                NewSolutionCallback new_solution_callback = [&, thread_id](
+                        const Output& local_search_output,
+                        const std::string& s)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    algorithm_formatter.update_solution(
+                            local_search_output.solution,
+                            "thread " + std::to_string(thread_id) + ", " + s);
+                };
+                if (thread_id % 2 == 0
+                        && instance.adjacency_list_graph() != nullptr) {
+                    LocalSearchRowWeightingParameters local_search_parameters;
+                    local_search_row_weighting_portfolio_set_parameters(
+                            parameters,
+                            goal,
+                            &solution,
+                            &shared_number_of_colors,
+                            new_solution_callback,
+                            local_search_parameters);
+                    numbers_of_iterations[thread_id] = local_search_row_weighting(
+                            instance,
+                            generators[thread_id],
+                            local_search_parameters).number_of_iterations;
+                } else {
+                    LocalSearchRowWeighting2Parameters local_search_parameters;
+                    local_search_row_weighting_portfolio_set_parameters(
+                            parameters,
+                            goal,
+                            &solution,
+                            &shared_number_of_colors,
+                            new_solution_callback,
+                            local_search_parameters);
+                    numbers_of_iterations[thread_id] = local_search_row_weighting_2(
+                            instance,
+                            generators[thread_id],
+                            local_search_parameters).number_of_iterations;
+                }
+            } catch (...) {
+                exceptions[thread_id] = std::current_exception();
+            }
+        }));
+    }
+    for (std::thread& thread: threads)
+        thread.join();
+    for (const std::exception_ptr& exception: exceptions)
+        if (exception)
+            std::rethrow_exception(exception);
+
+    for (Counter number_of_iterations: numbers_of_iterations)
+        output.number_of_iterations += number_of_iterations;
+
     algorithm_formatter.end();
     return output;
 }
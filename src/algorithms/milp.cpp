@@ -1,6 +1,7 @@
 #include "coloringsolver/algorithms/milp.hpp"
 
 #include "coloringsolver/algorithm_formatter.hpp"
+#include "coloringsolver/algorithms/greedy.hpp"
 
 #ifdef CBC_FOUND
 #include "mathoptsolverscmake/mathopt_cbc.hpp"
@@ -14,6 +15,97 @@
 
 using namespace coloringsolver;
 
+namespace
+{
+
+/**
+ * Get the initial solution of a MILP model.
+ *
+ * It is the best solution between the DSATUR solution and the repaired
+ * initial solution of the parameters. Its colors are consecutive, therefore,
+ * its number of colors is used as upper bound on the number of colors of the
+ * models.
+ */
+Solution milp_initial_solution(
+        const Instance& instance,
+        const MilpParameters& parameters)
+{
+    GreedyDsaturParameters greedy_parameters;
+    greedy_parameters.verbosity_level = 0;
+    Solution solution = greedy_dsatur(instance, greedy_parameters).solution;
+    if (parameters.initial_solution != nullptr) {
+        Solution solution_repaired = greedy_repair(
+                *parameters.initial_solution,
+                greedy_parameters).solution;
+        if (solution_repaired.number_of_colors() < solution.number_of_colors())
+            solution = solution_repaired;
+    }
+    return solution;
+}
+
+#ifdef CBC_FOUND
+
+void set_milp_start(
+        CbcModel& cbc_model,
+        const mathoptsolverscmake::MathOptModel& model,
+        const std::vector<double>& milp_start)
+{
+    if (milp_start.empty())
+        return;
+    double objective_value = 0;
+    for (int variable_id = 0;
+            variable_id < (int)milp_start.size();
+            ++variable_id) {
+        objective_value += model.objective_coefficients[variable_id]
+            * milp_start[variable_id];
+    }
+    cbc_model.setBestSolution(
+            milp_start.data(),
+            milp_start.size(),
+            objective_value,
+            true);
+}
+
+#endif
+
+#ifdef HIGHS_FOUND
+
+void set_milp_start(
+        Highs& highs,
+        const mathoptsolverscmake::MathOptModel&,
+        const std::vector<double>& milp_start)
+{
+    if (milp_start.empty())
+        return;
+    HighsSolution highs_solution;
+    highs_solution.value_valid = true;
+    highs_solution.col_value = milp_start;
+    highs.setSolution(highs_solution);
+}
+
+#endif
+
+#ifdef XPRESS_FOUND
+
+void set_milp_start(
+        XPRSprob xpress_model,
+        const mathoptsolverscmake::MathOptModel&,
+        const std::vector<double>& milp_start)
+{
+    if (milp_start.empty())
+        return;
+    XPRSaddmipsol(
+            xpress_model,
+            milp_start.size(),
+            milp_start.data(),
+            NULL,
+            "initial_solution");
+}
+
+#endif
+
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////// Assignment-based ILP model //////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -31,10 +123,14 @@ struct ModelAssignment
 
     /** y[c] = 1 iff color 'c' is used. */
     std::vector<int> y;
+
+    /** Upper bound on the number of colors. */
+    ColorId upper_bound;
 };
 
 ModelAssignment create_milp_model_assignment(
         const Instance& instance,
+        ColorId upper_bound,
         const MilpAssignmentParameters& parameters)
 {
     const optimizationtools::AdjacencyListGraph& graph = *instance.adjacency_list_graph();
@@ -48,7 +144,7 @@ ModelAssignment create_milp_model_assignment(
     model.model.objective_direction = mathoptsolverscmake::ObjectiveDirection::Minimize;
 
     // Variables x.
-    ColorId upper_bound = graph.highest_degree() + 1;
+    model.upper_bound = upper_bound;
     model.x = std::vector<std::vector<int>>(graph.number_of_vertices());
     for (VertexId vertex_id = 0;
             vertex_id < graph.number_of_vertices();
@@ -169,7 +265,7 @@ Solution retrieve_solution(
         const std::vector<double>& milp_solution)
 {
     const optimizationtools::AdjacencyListGraph& graph = *instance.adjacency_list_graph();
-    ColorId upper_bound = graph.highest_degree() + 1;
+    ColorId upper_bound = model.upper_bound;
 
     Solution solution(instance);
     for (VertexId vertex_id = 0;
@@ -184,6 +280,37 @@ Solution retrieve_solution(
     return solution;
 }
 
+/**
+ * Convert a feasible solution with consecutive colors into a MIP start.
+ *
+ * Return an empty vector if the solution uses too many colors.
+ */
+std::vector<double> create_milp_start(
+        const Instance& instance,
+        const ModelAssignment& model,
+        const Solution& solution)
+{
+    const optimizationtools::AdjacencyListGraph& graph = *instance.adjacency_list_graph();
+    ColorId upper_bound = model.upper_bound;
+    if (!solution.feasible()
+            || solution.number_of_colors() > upper_bound) {
+        return {};
+    }
+
+    std::vector<double> milp_start(model.model.variables_lower_bounds.size(), 0);
+    for (VertexId vertex_id = 0;
+            vertex_id < graph.number_of_vertices();
+            ++vertex_id) {
+        milp_start[model.x[vertex_id][solution.color(vertex_id)]] = 1;
+    }
+    for (ColorId color_id = 0;
+            color_id < solution.number_of_colors();
+            ++color_id) {
+        milp_start[model.y[color_id]] = 1;
+    }
+    return milp_start;
+}
+
 #ifdef CBC_FOUND
 
 class EventHandlerAssignment: public CbcEventHandler
@@ -298,6 +425,21 @@ void xpress_callback_assignment(
 
 }
 
+MilpModel coloringsolver::milp_assignment_model(
+        const Instance& instance,
+        const MilpAssignmentParameters& parameters)
+{
+    Solution initial_solution = milp_initial_solution(instance, parameters);
+    ModelAssignment milp_model = create_milp_model_assignment(
+            instance,
+            initial_solution.number_of_colors(),
+            parameters);
+    MilpModel model;
+    model.milp_start = create_milp_start(instance, milp_model, initial_solution);
+    model.model = std::move(milp_model.model);
+    return model;
+}
+
 Output coloringsolver::milp_assignment(
         const Instance& instance,
         const MilpAssignmentParameters& parameters)
@@ -307,8 +449,22 @@ Output coloringsolver::milp_assignment(
     algorithm_formatter.start("MILP - Assignment model");
 
     algorithm_formatter.print_header();
+    algorithm_formatter.update_clique_bound();
+
+    // Initial solution.
+    // The model only has as many colors as the initial solution.
+    Solution initial_solution = milp_initial_solution(instance, parameters);
+    algorithm_formatter.update_solution(initial_solution, "initial solution");
+    if (algorithm_formatter.optimal()) {
+        algorithm_formatter.end();
+        return output;
+    }
 
-    ModelAssignment milp_model = create_milp_model_assignment(instance, parameters);
+    ModelAssignment milp_model = create_milp_model_assignment(
+            instance,
+            initial_solution.number_of_colors(),
+            parameters);
+    std::vector<double> milp_start = create_milp_start(instance, milp_model, initial_solution);
 
     std::vector<double> milp_solution;
     double milp_bound = 0;
@@ -320,6 +476,7 @@ Output coloringsolver::milp_assignment(
         mathoptsolverscmake::reduce_printout(cbc_model);
         mathoptsolverscmake::set_time_limit(cbc_model, parameters.timer.remaining_time());
         mathoptsolverscmake::load(cbc_model, milp_model.model);
+        set_milp_start(cbc_model, milp_model.model, milp_start);
         EventHandlerAssignment cbc_event_handler(instance, parameters, milp_model, output, algorithm_formatter);
         cbc_model.passInEventHandler(&cbc_event_handler);
         mathoptsolverscmake::solve(cbc_model);
@@ -336,6 +493,7 @@ Output coloringsolver::milp_assignment(
         mathoptsolverscmake::set_time_limit(highs, parameters.timer.remaining_time());
         mathoptsolverscmake::set_log_file(highs, "highs.log");
         mathoptsolverscmake::load(highs, milp_model.model);
+        set_milp_start(highs, milp_model.model, milp_start);
         highs.setCallback([
                 &instance,
                 &parameters,
@@ -385,6 +543,7 @@ Output coloringsolver::milp_assignment(
         mathoptsolverscmake::set_time_limit(xpress_model, parameters.timer.remaining_time());
         mathoptsolverscmake::set_log_file(xpress_model, "xpress.log");
         mathoptsolverscmake::load(xpress_model, milp_model);
+        set_milp_start(xpress_model, milp_model.model, milp_start);
         //mathoptsolverscmake::write_mps(xpress_model, "kpc.mps");
         XpressCallbackUser xpress_callback_user{instance, parameters, output, algorithm_formatter};
         XPRSaddcbprenode(xpress_model, xpress_callback_assignment, (void*)&xpress_callback_user, 0);
@@ -424,15 +583,54 @@ struct ModelRepresentatives
     /** Model. */
     mathoptsolverscmake::MathOptModel model;
 
-    /** x[u][v] = 1 iff vertex 'u' is represented by vertex 'v'. */
-    std::vector<std::vector<int>> x;
+    /**
+     * x[u][v] = 1 iff vertex 'u' represents vertex 'v'.
+     *
+     * Variables only exist if 'u <= v' and 'u' and 'v' are not adjacent,
+     * therefore, the representative of a color is its vertex of smallest id.
+     *
+     * The variables of the vertices represented by vertex 'u' are the
+     * variables 'x_starts[u]' to 'x_starts[u + 1] - 1'. They are sorted by
+     * represented vertex and the first one is 'x[u][u]'.
+     */
+    std::vector<int> x_starts;
+
+    /** Vertex represented by each variable. */
+    std::vector<VertexId> x_vertices;
 };
 
+/**
+ * Get the variable x[u][v].
+ *
+ * Return -1 if it doesn't exist.
+ */
+int milp_representatives_variable(
+        const ModelRepresentatives& model,
+        VertexId vertex_id,
+        VertexId vertex_2_id)
+{
+    auto begin = model.x_vertices.begin() + model.x_starts[vertex_id];
+    auto end = model.x_vertices.begin() + model.x_starts[vertex_id + 1];
+    auto it = std::lower_bound(begin, end, vertex_2_id);
+    if (it == end || *it != vertex_2_id)
+        return -1;
+    return it - model.x_vertices.begin();
+}
+
+/**
+ * Create the representatives model of "Cliques, holes and the vertex
+ * coloring polytope" (Campêlo et al., 2004).
+ *
+ * The complementary graph is never built. The anti-neighbors of a vertex are
+ * enumerated by marking its neighbors. The constraints preventing a
+ * representative from representing both ends of an edge are aggregated on
+ * the neighborhood of the represented vertex, so that there is one
+ * constraint per variable instead of one per edge and vertex.
+ */
 ModelRepresentatives create_milp_model_representatives(
         const Instance& instance)
 {
     const optimizationtools::AdjacencyListGraph& graph = *instance.adjacency_list_graph();
-    optimizationtools::AdjacencyListGraph complementary_graph = graph.complementary();
 
     ModelRepresentatives model;
 
@@ -443,15 +641,25 @@ ModelRepresentatives create_milp_model_representatives(
     model.model.objective_direction = mathoptsolverscmake::ObjectiveDirection::Minimize;
 
     // Variables x.
-    model.x = std::vector<std::vector<int>>(graph.number_of_vertices());
+    // neighbor_marks[v] == u iff vertices 'u' and 'v' are adjacent.
+    std::vector<VertexId> neighbor_marks(graph.number_of_vertices(), -1);
+    std::vector<VertexPos> numbers_of_representatives(graph.number_of_vertices(), 0);
+    model.x_starts.push_back(0);
     for (VertexId vertex_id = 0;
             vertex_id < graph.number_of_vertices();
             ++vertex_id) {
-        model.x[vertex_id] = std::vector<int>(graph.number_of_vertices());
-        for (VertexId vertex_2_id = 0;
+        for (auto it = graph.neighbors_begin(vertex_id);
+                it != graph.neighbors_end(vertex_id);
+                ++it) {
+            neighbor_marks[*it] = vertex_id;
+        }
+        for (VertexId vertex_2_id = vertex_id;
                 vertex_2_id < graph.number_of_vertices();
                 ++vertex_2_id) {
-            model.x[vertex_id][vertex_2_id] = model.model.variables_lower_bounds.size();
+            if (neighbor_marks[vertex_2_id] == vertex_id)
+                continue;
+            model.x_vertices.push_back(vertex_2_id);
+            numbers_of_representatives[vertex_2_id]++;
             model.model.variables_names.push_back("x_{" + std::to_string(vertex_id) + "," + std::to_string(vertex_2_id) + "}");
             model.model.variables_lower_bounds.push_back(0);
             model.model.variables_upper_bounds.push_back(1);
@@ -462,6 +670,7 @@ ModelRepresentatives create_milp_model_representatives(
                 model.model.objective_coefficients.push_back(0);
             }
         }
+        model.x_starts.push_back(model.x_vertices.size());
     }
 
     /////////////////
@@ -469,67 +678,88 @@ ModelRepresentatives create_milp_model_representatives(
     /////////////////
 
     // Constraints: every vertex must have a representative (possibly itself).
+    // The variables are bucketed by represented vertex first.
+    std::vector<int> representatives_starts(graph.number_of_vertices() + 1, 0);
+    for (VertexId vertex_id = 0;
+            vertex_id < graph.number_of_vertices();
+            ++vertex_id) {
+        representatives_starts[vertex_id + 1] = representatives_starts[vertex_id]
+            + numbers_of_representatives[vertex_id];
+    }
+    std::vector<int> representatives(model.x_vertices.size());
+    std::vector<int> representatives_positions(
+            representatives_starts.begin(),
+            representatives_starts.end() - 1);
+    for (int variable_id = 0;
+            variable_id < (int)model.x_vertices.size();
+            ++variable_id) {
+        VertexId vertex_id = model.x_vertices[variable_id];
+        representatives[representatives_positions[vertex_id]++] = variable_id;
+    }
     for (VertexId vertex_id = 0;
             vertex_id < graph.number_of_vertices();
             ++vertex_id) {
         model.model.constraints_starts.push_back(model.model.elements_variables.size());
-
-        model.model.elements_variables.push_back(model.x[vertex_id][vertex_id]);
-        model.model.elements_coefficients.push_back(1.0);
-        for (auto it = complementary_graph.neighbors_begin(vertex_id);
-                it != complementary_graph.neighbors_end(vertex_id);
-                ++it) {
-            model.model.elements_variables.push_back(model.x[*it][vertex_id]);
+        for (int pos = representatives_starts[vertex_id];
+                pos < representatives_starts[vertex_id + 1];
+                ++pos) {
+            model.model.elements_variables.push_back(representatives[pos]);
             model.model.elements_coefficients.push_back(1.0);
         }
-
         model.model.constraints_lower_bounds.push_back(1);
         model.model.constraints_upper_bounds.push_back(std::numeric_limits<double>::infinity());
     }
 
-    // Constraint: a representative cannot represent both endpoints of an edge.
-    for (EdgeId edge_id = 0; edge_id < graph.number_of_edges(); ++edge_id) {
-        for (VertexId vertex_id = 0;
-                vertex_id < graph.number_of_vertices();
-                ++vertex_id) {
-            if (vertex_id == graph.first_end(edge_id)
-                    || vertex_id == graph.second_end(edge_id)) {
-                continue;
+    // Constraints: a representative cannot represent both ends of an edge.
+    // For a representative 'u', a vertex 'v' represented by 'u' and the set
+    // 'W' of the neighbors of 'v' which may be represented by 'u':
+    // d x[u][v] + sum_{w in W} x[u][w] <= d x[u][u]
+    // with 'd = max(|W|, 1)'. It also enforces x[u][v] <= x[u][u].
+    std::fill(neighbor_marks.begin(), neighbor_marks.end(), -1);
+    std::vector<int> variable_ids(graph.number_of_vertices(), -1);
+    std::vector<int> neighbor_variable_ids;
+    for (VertexId vertex_id = 0;
+            vertex_id < graph.number_of_vertices();
+            ++vertex_id) {
+        for (auto it = graph.neighbors_begin(vertex_id);
+                it != graph.neighbors_end(vertex_id);
+                ++it) {
+            neighbor_marks[*it] = vertex_id;
+        }
+        for (int variable_id = model.x_starts[vertex_id];
+                variable_id < model.x_starts[vertex_id + 1];
+                ++variable_id) {
+            variable_ids[model.x_vertices[variable_id]] = variable_id;
+        }
+
+        int variable_uu_id = model.x_starts[vertex_id];
+        for (int variable_id = model.x_starts[vertex_id] + 1;
+                variable_id < model.x_starts[vertex_id + 1];
+                ++variable_id) {
+            VertexId vertex_2_id = model.x_vertices[variable_id];
+            neighbor_variable_ids.clear();
+            for (auto it = graph.neighbors_begin(vertex_2_id);
+                    it != graph.neighbors_end(vertex_2_id);
+                    ++it) {
+                VertexId vertex_3_id = *it;
+                if (vertex_3_id > vertex_id
+                        && neighbor_marks[vertex_3_id] != vertex_id) {
+                    neighbor_variable_ids.push_back(variable_ids[vertex_3_id]);
+                }
             }
+            double d = std::max((double)neighbor_variable_ids.size(), 1.0);
 
             model.model.constraints_starts.push_back(model.model.elements_variables.size());
 
-            model.model.elements_variables.push_back(model.x[vertex_id][graph.first_end(edge_id)]);
-            model.model.elements_coefficients.push_back(1.0);
-            model.model.elements_variables.push_back(model.x[vertex_id][graph.second_end(edge_id)]);
-            model.model.elements_coefficients.push_back(1.0);
-            model.model.elements_variables.push_back(model.x[vertex_id][vertex_id]);
-            model.model.elements_coefficients.push_back(-1.0);
-
-            model.model.constraints_lower_bounds.push_back(-std::numeric_limits<double>::infinity());
-            model.model.constraints_upper_bounds.push_back(0);
-        }
-    }
+            model.model.elements_variables.push_back(variable_id);
+            model.model.elements_coefficients.push_back(d);
+            for (int neighbor_variable_id: neighbor_variable_ids) {
+                model.model.elements_variables.push_back(neighbor_variable_id);
+                model.model.elements_coefficients.push_back(1.0);
+            }
+            model.model.elements_variables.push_back(variable_uu_id);
+            model.model.elements_coefficients.push_back(-d);
 
-    // Handle isolated vertices: for each isolated vertex v and each potential
-    // representative u != v, enforce x[u][v] <= x[u][u]. For non-isolated v
-    // this is already implied by the edge constraints above, but isolated
-    // vertices never appear as edge endpoints so the link is missing.
-    for (VertexId vertex_id = 0;
-            vertex_id < graph.number_of_vertices();
-            ++vertex_id) {
-        if (graph.degree(vertex_id) > 0)
-            continue;
-        for (VertexId vertex_2_id = 0;
-                vertex_2_id < graph.number_of_vertices();
-                ++vertex_2_id) {
-            if (vertex_2_id == vertex_id)
-                continue;
-            model.model.constraints_starts.push_back(model.model.elements_variables.size());
-            model.model.elements_variables.push_back(model.x[vertex_2_id][vertex_id]);
-            model.model.elements_coefficients.push_back(1.0);
-            model.model.elements_variables.push_back(model.x[vertex_2_id][vertex_2_id]);
-            model.model.elements_coefficients.push_back(-1.0);
             model.model.constraints_lower_bounds.push_back(-std::numeric_limits<double>::infinity());
             model.model.constraints_upper_bounds.push_back(0);
         }
@@ -549,22 +779,49 @@ Solution retrieve_solution(
     for (VertexId vertex_id = 0;
             vertex_id < graph.number_of_vertices();
             ++vertex_id) {
-        for (VertexId vertex_2_id = 0;
-                vertex_2_id < graph.number_of_vertices();
-                ++vertex_2_id) {
-            //std::cout << "vertex_id " << vertex_id
-            //    << " vertex_2_id " << vertex_2_id
-            //    << " x " << milp_solution[model.x[vertex_2_id][vertex_id]]
-            //    << std::endl;
-            if (milp_solution[model.x[vertex_2_id][vertex_id]] > 0.5) {
-                solution.set(vertex_id, vertex_2_id);
-                break;
+        for (int variable_id = model.x_starts[vertex_id];
+                variable_id < model.x_starts[vertex_id + 1];
+                ++variable_id) {
+            VertexId vertex_2_id = model.x_vertices[variable_id];
+            if (milp_solution[variable_id] > 0.5
+                    && !solution.contains(vertex_2_id)) {
+                solution.set(vertex_2_id, vertex_id);
             }
         }
     }
     return solution;
 }
 
+/**
+ * Convert a feasible solution into a MIP start.
+ *
+ * The representative of each color is its vertex of smallest id.
+ */
+std::vector<double> create_milp_start(
+        const Instance& instance,
+        const ModelRepresentatives& model,
+        const Solution& solution)
+{
+    const optimizationtools::AdjacencyListGraph& graph = *instance.adjacency_list_graph();
+    if (!solution.feasible())
+        return {};
+
+    std::vector<double> milp_start(model.model.variables_lower_bounds.size(), 0);
+    std::vector<VertexId> representatives(graph.number_of_vertices(), -1);
+    for (VertexId vertex_id = 0;
+            vertex_id < graph.number_of_vertices();
+            ++vertex_id) {
+        ColorId color_id = solution.color(vertex_id);
+        if (representatives[color_id] == -1)
+            representatives[color_id] = vertex_id;
+        milp_start[milp_representatives_variable(
+                model,
+                representatives[color_id],
+                vertex_id)] = 1;
+    }
+    return milp_start;
+}
+
 #ifdef CBC_FOUND
 
 class EventHandlerRepresentatives: public CbcEventHandler
@@ -679,6 +936,18 @@ void xpress_callback_representatives(
 
 }
 
+MilpModel coloringsolver::milp_representatives_model(
+        const Instance& instance,
+        const MilpParameters& parameters)
+{
+    Solution initial_solution = milp_initial_solution(instance, parameters);
+    ModelRepresentatives milp_model = create_milp_model_representatives(instance);
+    MilpModel model;
+    model.milp_start = create_milp_start(instance, milp_model, initial_solution);
+    model.model = std::move(milp_model.model);
+    return model;
+}
+
 Output coloringsolver::milp_representatives(
         const Instance& instance,
         const MilpParameters& parameters)
@@ -687,8 +956,18 @@ Output coloringsolver::milp_representatives(
     AlgorithmFormatter algorithm_formatter(parameters, output);
     algorithm_formatter.start("MILP - Representative model");
     algorithm_formatter.print_header();
+    algorithm_formatter.update_clique_bound();
+
+    // Initial solution.
+    Solution initial_solution = milp_initial_solution(instance, parameters);
+    algorithm_formatter.update_solution(initial_solution, "initial solution");
+    if (algorithm_formatter.optimal()) {
+        algorithm_formatter.end();
+        return output;
+    }
 
     ModelRepresentatives milp_model = create_milp_model_representatives(instance);
+    std::vector<double> milp_start = create_milp_start(instance, milp_model, initial_solution);
 
     std::vector<double> milp_solution;
     double milp_bound = 0;
@@ -700,6 +979,7 @@ Output coloringsolver::milp_representatives(
         mathoptsolverscmake::reduce_printout(cbc_model);
         mathoptsolverscmake::set_time_limit(cbc_model, parameters.timer.remaining_time());
         mathoptsolverscmake::load(cbc_model, milp_model.model);
+        set_milp_start(cbc_model, milp_model.model, milp_start);
         EventHandlerRepresentatives cbc_event_handler(instance, parameters, milp_model, output, algorithm_formatter);
         cbc_model.passInEventHandler(&cbc_event_handler);
         mathoptsolverscmake::solve(cbc_model);
@@ -716,6 +996,7 @@ Output coloringsolver::milp_representatives(
         mathoptsolverscmake::set_time_limit(highs, parameters.timer.remaining_time());
         mathoptsolverscmake::set_log_file(highs, "highs.log");
         mathoptsolverscmake::load(highs, milp_model.model);
+        set_milp_start(highs, milp_model.model, milp_start);
         highs.setCallback([
                 &instance,
                 &parameters,
@@ -765,6 +1046,7 @@ Output coloringsolver::milp_representatives(
         mathoptsolverscmake::set_time_limit(xpress_model, parameters.timer.remaining_time());
         mathoptsolverscmake::set_log_file(xpress_model, "xpress.log");
         mathoptsolverscmake::load(xpress_model, milp_model);
+        set_milp_start(xpress_model, milp_model.model, milp_start);
         //mathoptsolverscmake::write_mps(xpress_model, "kpc.mps");
         XpressCallbackUser xpress_callback_user{instance, parameters, output, algorithm_formatter};
         XPRSaddcbprenode(xpress_model, xpress_callback_representatives, (void*)&xpress_callback_user, 0);
@@ -816,10 +1098,14 @@ struct ModelPartialOrdering
 
     /** y[v][c] == 1 iff vertex 'v' has color < 'c'. */
     std::vector<std::vector<int>> z;
+
+    /** Upper bound on the number of colors. */
+    ColorId upper_bound;
 };
 
 ModelPartialOrdering create_milp_model_partial_ordering(
         const Instance& instance,
+        ColorId upper_bound,
         const MilpPartialOrderingParameters& parameters)
 {
     const optimizationtools::AdjacencyListGraph& graph = *instance.adjacency_list_graph();
@@ -832,7 +1118,7 @@ ModelPartialOrdering create_milp_model_partial_ordering(
 
     model.model.objective_direction = mathoptsolverscmake::ObjectiveDirection::Minimize;
 
-    ColorId upper_bound = graph.highest_degree() + 1;
+    model.upper_bound = upper_bound;
 
     // Variables y and z.
     model.y = std::vector<std::vector<int>>(graph.number_of_vertices());
@@ -1015,7 +1301,7 @@ Solution retrieve_solution(
         const std::vector<double>& milp_solution)
 {
     const optimizationtools::AdjacencyListGraph& graph = *instance.adjacency_list_graph();
-    ColorId upper_bound = graph.highest_degree() + 1;
+    ColorId upper_bound = model.upper_bound;
 
     Solution solution(instance);
     for (VertexId vertex_id = 0;
@@ -1030,6 +1316,51 @@ Solution retrieve_solution(
     return solution;
 }
 
+/**
+ * Convert a feasible solution with consecutive colors into a MIP start.
+ *
+ * In the model, vertex 0 has the largest color, therefore, its color is
+ * swapped with the largest one.
+ *
+ * Return an empty vector if the solution uses too many colors.
+ */
+std::vector<double> create_milp_start(
+        const Instance& instance,
+        const ModelPartialOrdering& model,
+        const Solution& solution)
+{
+    const optimizationtools::AdjacencyListGraph& graph = *instance.adjacency_list_graph();
+    ColorId upper_bound = model.upper_bound;
+    if (!solution.feasible()
+            || graph.number_of_vertices() == 0
+            || solution.number_of_colors() > upper_bound) {
+        return {};
+    }
+
+    ColorId color_id_last = solution.number_of_colors() - 1;
+    ColorId color_id_0 = solution.color(0);
+    std::vector<double> milp_start(model.model.variables_lower_bounds.size(), 0);
+    for (VertexId vertex_id = 0;
+            vertex_id < graph.number_of_vertices();
+            ++vertex_id) {
+        ColorId color_id_vertex = solution.color(vertex_id);
+        if (color_id_vertex == color_id_0) {
+            color_id_vertex = color_id_last;
+        } else if (color_id_vertex == color_id_last) {
+            color_id_vertex = color_id_0;
+        }
+        for (ColorId color_id = 0; color_id < upper_bound; ++color_id) {
+            if (color_id_vertex > color_id)
+                milp_start[model.y[vertex_id][color_id]] = 1;
+            if (color_id_vertex < color_id)
+                milp_start[model.z[vertex_id][color_id]] = 1;
+            if (!model.x.empty() && color_id_vertex == color_id)
+                milp_start[model.x[vertex_id][color_id]] = 1;
+        }
+    }
+    return milp_start;
+}
+
 #ifdef CBC_FOUND
 
 class EventHandlerPartialOrdering: public CbcEventHandler
@@ -1144,6 +1475,21 @@ void xpress_callback_partial_ordering(
 
 }
 
+MilpModel coloringsolver::milp_partial_ordering_model(
+        const Instance& instance,
+        const MilpPartialOrderingParameters& parameters)
+{
+    Solution initial_solution = milp_initial_solution(instance, parameters);
+    ModelPartialOrdering milp_model = create_milp_model_partial_ordering(
+            instance,
+            initial_solution.number_of_colors(),
+            parameters);
+    MilpModel model;
+    model.milp_start = create_milp_start(instance, milp_model, initial_solution);
+    model.model = std::move(milp_model.model);
+    return model;
+}
+
 Output coloringsolver::milp_partial_ordering(
         const Instance& instance,
         const MilpPartialOrderingParameters& parameters)
@@ -1153,8 +1499,22 @@ Output coloringsolver::milp_partial_ordering(
     algorithm_formatter.start("MILP - Partial ordering model");
 
     algorithm_formatter.print_header();
+    algorithm_formatter.update_clique_bound();
+
+    // Initial solution.
+    // The model only has as many colors as the initial solution.
+    Solution initial_solution = milp_initial_solution(instance, parameters);
+    algorithm_formatter.update_solution(initial_solution, "initial solution");
+    if (algorithm_formatter.optimal()) {
+        algorithm_formatter.end();
+        return output;
+    }
 
-    ModelPartialOrdering milp_model = create_milp_model_partial_ordering(instance, parameters);
+    ModelPartialOrdering milp_model = create_milp_model_partial_ordering(
+            instance,
+            initial_solution.number_of_colors(),
+            parameters);
+    std::vector<double> milp_start = create_milp_start(instance, milp_model, initial_solution);
 
     std::vector<double> milp_solution;
     double milp_bound = 0;
@@ -1166,6 +1526,7 @@ Output coloringsolver::milp_partial_ordering(
         mathoptsolverscmake::reduce_printout(cbc_model);
         mathoptsolverscmake::set_time_limit(cbc_model, parameters.timer.remaining_time());
         mathoptsolverscmake::load(cbc_model, milp_model.model);
+        set_milp_start(cbc_model, milp_model.model, milp_start);
         EventHandlerPartialOrdering cbc_event_handler(instance, parameters, milp_model, output, algorithm_formatter);
         cbc_model.passInEventHandler(&cbc_event_handler);
         mathoptsolverscmake::solve(cbc_model);
@@ -1182,6 +1543,7 @@ Output coloringsolver::milp_partial_ordering(
         mathoptsolverscmake::set_time_limit(highs, parameters.timer.remaining_time());
         mathoptsolverscmake::set_log_file(highs, "highs.log");
         mathoptsolverscmake::load(highs, milp_model.model);
+        set_milp_start(highs, milp_model.model, milp_start);
         highs.setCallback([
                 &instance,
                 &parameters,
@@ -1231,6 +1593,7 @@ Output coloringsolver::milp_partial_ordering(
         mathoptsolverscmake::set_time_limit(xpress_model, parameters.timer.remaining_time());
         mathoptsolverscmake::set_log_file(xpress_model, "xpress.log");
         mathoptsolverscmake::load(xpress_model, milp_model);
+        set_milp_start(xpress_model, milp_model.model, milp_start);
         //mathoptsolverscmake::write_mps(xpress_model, "kpc.mps");
         XpressCallbackUser xpress_callback_user{instance, parameters, output, algorithm_formatter};
         XPRSaddcbprenode(xpress_model, xpress_callback_partial_ordering, (void*)&xpress_callback_user, 0);
@@ -0,0 +1,408 @@
+#include "coloringsolver/algorithms/recoloring.hpp"
+
+#include "coloringsolver/algorithms/local_search_row_weighting.hpp"
+#include "coloringsolver/algorithm_formatter.hpp"
+#include "coloringsolver/color_availability.hpp"
+
+#include <unordered_set>
+
+using namespace coloringsolver;
+
+namespace
+{
+
+using RecolorEdge = std::pair<VertexId, VertexId>;
+
+struct RecolorEdgeHash
+{
+    std::size_t operator()(const RecolorEdge& edge) const
+    {
+        return std::hash<VertexId>()(edge.first) * 31
+            + std::hash<VertexId>()(edge.second);
+    }
+};
+
+/** Get an edge with its smallest end first. */
+inline RecolorEdge recolor_edge(
+        VertexId vertex_id_1,
+        VertexId vertex_id_2)
+{
+    return {
+        (std::min)(vertex_id_1, vertex_id_2),
+        (std::max)(vertex_id_1, vertex_id_2)};
+}
+
+/** Return 'true' iff two vertices are adjacent. */
+bool recolor_adjacent(
+        const optimizationtools::AbstractGraph& graph,
+        VertexId vertex_id_1,
+        VertexId vertex_id_2)
+{
+    if (graph.degree(vertex_id_1) > graph.degree(vertex_id_2))
+        std::swap(vertex_id_1, vertex_id_2);
+    auto it = graph.neighbors_begin(vertex_id_1);
+    auto it_end = graph.neighbors_end(vertex_id_1);
+    for (; it != it_end; ++it)
+        if (*it == vertex_id_2)
+            return true;
+    return false;
+}
+
+/** Scratch structures of the Kempe chain interchanges. */
+struct RecolorKempeChainBuffers
+{
+    RecolorKempeChainBuffers(VertexId number_of_vertices):
+        chain_timestamps(number_of_vertices, 0),
+        neighbor_timestamps(number_of_vertices, 0),
+        number_of_neighbors(number_of_vertices, 0) { }
+
+    /** Vertices of the current chain. */
+    std::vector<VertexId> chain;
+
+    /** chain_timestamps[v] == chain_timestamp iff 'v' is in the chain. */
+    std::vector<Counter> chain_timestamps;
+
+    Counter chain_timestamp = 0;
+
+    /**
+     * neighbor_timestamps[v] == neighbor_timestamp iff 'v' is a neighbor of
+     * the vertex to color.
+     */
+    std::vector<Counter> neighbor_timestamps;
+
+    Counter neighbor_timestamp = 0;
+
+    /**
+     * Number of neighbors of the vertex to color having each color.
+     *
+     * Only the entries of 'neighbor_colors' are non-zero, and they are reset
+     * to 0 before returning.
+     */
+    std::vector<VertexPos> number_of_neighbors;
+
+    /** Colors of the neighbors of the vertex to color. */
+    std::vector<ColorId> neighbor_colors;
+};
+
+/**
+ * Free a color for an uncolored vertex with a Kempe chain interchange.
+ *
+ * For two colors 'c1' and 'c2', the Kempe chain of the neighbors of the
+ * vertex with color 'c1' is the set of vertices with color 'c1' or 'c2'
+ * reachable from them through vertices with color 'c1' or 'c2'. If it doesn't
+ * contain a neighbor of the vertex with color 'c2', swapping the two colors in
+ * the chain keeps the solution feasible and frees color 'c1' for the vertex.
+ *
+ * If a color used by the solution is not used by the neighbors of the vertex,
+ * it is returned without interchange. Otherwise, both 'c1' and 'c2' are
+ * colors of the neighbors.
+ *
+ * Return the freed color, '-1' if no interchange has been found.
+ */
+ColorId recolor_kempe_chain_interchange(
+        Solution& solution,
+        VertexId vertex_id,
+        VertexId maximum_kempe_chain_size,
+        RecolorKempeChainBuffers& buffers)
+{
+    const optimizationtools::AbstractGraph& graph = solution.instance().graph();
+
+    // Count the neighbors of each color.
+    buffers.neighbor_timestamp++;
+    buffers.neighbor_colors.clear();
+    auto it = graph.neighbors_begin(vertex_id);
+    auto it_end = graph.neighbors_end(vertex_id);
+    for (; it != it_end; ++it) {
+        buffers.neighbor_timestamps[*it] = buffers.neighbor_timestamp;
+        if (!solution.contains(*it))
+            continue;
+        ColorId color_id = solution.color(*it);
+        if (buffers.number_of_neighbors[color_id] == 0)
+            buffers.neighbor_colors.push_back(color_id);
+        buffers.number_of_neighbors[color_id]++;
+    }
+    // Try first the colors of few neighbors, which are more likely to have
+    // small chains, and, as 'c2', less likely to reach a neighbor.
+    std::sort(
+            buffers.neighbor_colors.begin(),
+            buffers.neighbor_colors.end(),
+            [&buffers](ColorId color_id_1, ColorId color_id_2)
+            {
+                if (buffers.number_of_neighbors[color_id_1]
+                        != buffers.number_of_neighbors[color_id_2]) {
+                    return buffers.number_of_neighbors[color_id_1]
+                        < buffers.number_of_neighbors[color_id_2];
+                }
+                return color_id_1 < color_id_2;
+            });
+    ColorId color_id_freed = -1;
+    if ((ColorId)buffers.neighbor_colors.size() < solution.number_of_colors()) {
+        for (auto it_color = solution.colors_begin();
+                it_color != solution.colors_end();
+                ++it_color) {
+            if (buffers.number_of_neighbors[*it_color] == 0) {
+                color_id_freed = *it_color;
+                break;
+            }
+        }
+    }
+    for (ColorId color_id: buffers.neighbor_colors)
+        buffers.number_of_neighbors[color_id] = 0;
+    if (color_id_freed != -1)
+        return color_id_freed;
+
+    for (ColorId color_id_1: buffers.neighbor_colors) {
+        for (ColorId color_id_2: buffers.neighbor_colors) {
+            if (color_id_2 == color_id_1)
+                continue;
+
+            // Build the chain.
+            buffers.chain_timestamp++;
+            buffers.chain.clear();
+            for (it = graph.neighbors_begin(vertex_id); it != it_end; ++it) {
+                if (solution.contains(*it)
+                        && solution.color(*it) == color_id_1
+                        && buffers.chain_timestamps[*it] != buffers.chain_timestamp) {
+                    buffers.chain_timestamps[*it] = buffers.chain_timestamp;
+                    buffers.chain.push_back(*it);
+                }
+            }
+            bool ok = true;
+            for (VertexPos chain_pos = 0;
+                    ok && chain_pos < (VertexPos)buffers.chain.size();
+                    ++chain_pos) {
+                VertexId vertex_id_chain = buffers.chain[chain_pos];
+                auto it_chain = graph.neighbors_begin(vertex_id_chain);
+                auto it_chain_end = graph.neighbors_end(vertex_id_chain);
+                for (; it_chain != it_chain_end; ++it_chain) {
+                    VertexId vertex_id_neighbor = *it_chain;
+                    if (!solution.contains(vertex_id_neighbor))
+                        continue;
+                    ColorId color_id = solution.color(vertex_id_neighbor);
+                    if (color_id != color_id_1 && color_id != color_id_2)
+                        continue;
+                    if (buffers.chain_timestamps[vertex_id_neighbor] == buffers.chain_timestamp)
+                        continue;
+                    if (color_id == color_id_2
+                            && buffers.neighbor_timestamps[vertex_id_neighbor] == buffers.neighbor_timestamp) {
+                        ok = false;
+                        break;
+                    }
+                    buffers.chain_timestamps[vertex_id_neighbor] = buffers.chain_timestamp;
+                    buffers.chain.push_back(vertex_id_neighbor);
+                    if ((VertexPos)buffers.chain.size() > maximum_kempe_chain_size) {
+                        ok = false;
+                        break;
+                    }
+                }
+            }
+            if (!ok)
+                continue;
+
+            // Swap the colors of the chain.
+            for (VertexId vertex_id_chain: buffers.chain) {
+                solution.set(
+                        vertex_id_chain,
+                        (solution.color(vertex_id_chain) == color_id_1)?
+                        color_id_2: color_id_1);
+            }
+            return color_id_1;
+        }
+    }
+    return -1;
+}
+
+}
+
+const RecolorOutput coloringsolver::recolor(
+        const Solution& solution,
+        const GraphDelta& graph_delta,
+        std::mt19937_64& generator,
+        const RecolorParameters& parameters)
+{
+    const Instance& instance = solution.instance();
+    const optimizationtools::AbstractGraph& graph = instance.graph();
+    VertexId number_of_vertices_old = graph.number_of_vertices();
+    VertexId number_of_vertices_delta = number_of_vertices_old
+        + graph_delta.number_of_added_vertices;
+    auto check_vertex = [number_of_vertices_delta](VertexId vertex_id)
+    {
+        if (vertex_id < 0 || vertex_id >= number_of_vertices_delta) {
+            throw std::out_of_range(
+                    "Invalid vertex id: " + std::to_string(vertex_id) + ".");
+        }
+    };
+
+    // Compute the ids of the vertices in the changed graph.
+    std::vector<VertexId> vertex_ids(number_of_vertices_delta, 0);
+    for (VertexId vertex_id: graph_delta.removed_vertices) {
+        check_vertex(vertex_id);
+        vertex_ids[vertex_id] = -1;
+    }
+    VertexId number_of_vertices = 0;
+    for (VertexId vertex_id = 0; vertex_id < number_of_vertices_delta; ++vertex_id)
+        if (vertex_ids[vertex_id] != -1)
+            vertex_ids[vertex_id] = number_of_vertices++;
+
+    // Build the changed graph.
+    std::unordered_set<RecolorEdge, RecolorEdgeHash> removed_edges;
+    for (const RecolorEdge& edge: graph_delta.removed_edges) {
+        check_vertex(edge.first);
+        check_vertex(edge.second);
+        removed_edges.insert(recolor_edge(edge.first, edge.second));
+    }
+    optimizationtools::AdjacencyListGraphBuilder graph_builder;
+    for (VertexId vertex_id = 0; vertex_id < number_of_vertices; ++vertex_id)
+        graph_builder.add_vertex();
+    for (VertexId vertex_id = 0; vertex_id < number_of_vertices_old; ++vertex_id) {
+        VertexId original_vertex_id = instance.original_vertex_id(vertex_id);
+        if (vertex_ids[original_vertex_id] == -1)
+            continue;
+        auto it = graph.neighbors_begin(vertex_id);
+        auto it_end = graph.neighbors_end(vertex_id);
+        for (; it != it_end; ++it) {
+            VertexId original_vertex_id_neighbor = instance.original_vertex_id(*it);
+            if (original_vertex_id_neighbor <= original_vertex_id
+                    || vertex_ids[original_vertex_id_neighbor] == -1
+                    || removed_edges.count(recolor_edge(original_vertex_id, original_vertex_id_neighbor))) {
+                continue;
+            }
+            graph_builder.add_edge(
+                    vertex_ids[original_vertex_id],
+                    vertex_ids[original_vertex_id_neighbor]);
+        }
+    }
+    std::unordered_set<RecolorEdge, RecolorEdgeHash> added_edges;
+    for (const RecolorEdge& edge: graph_delta.added_edges) {
+        check_vertex(edge.first);
+        check_vertex(edge.second);
+        if (edge.first == edge.second
+                || vertex_ids[edge.first] == -1
+                || vertex_ids[edge.second] == -1) {
+            throw std::invalid_argument(
+                    "Invalid added edge (" + std::to_string(edge.first)
+                    + ", " + std::to_string(edge.second) + ").");
+        }
+        RecolorEdge added_edge = recolor_edge(edge.first, edge.second);
+        if (!added_edges.insert(added_edge).second)
+            continue;
+        // Skip the edges which are already in the graph.
+        if (added_edge.second < number_of_vertices_old
+                && !removed_edges.count(added_edge)
+                && recolor_adjacent(
+                    graph,
+                    instance.vertex_id(added_edge.first),
+                    instance.vertex_id(added_edge.second))) {
+            continue;
+        }
+        graph_builder.add_edge(
+                vertex_ids[added_edge.first],
+                vertex_ids[added_edge.second]);
+    }
+    auto instance_new = std::make_shared<const Instance>(
+            std::shared_ptr<const optimizationtools::AbstractGraph>(
+                new optimizationtools::AdjacencyListGraph(graph_builder.build())));
+    const optimizationtools::AbstractGraph& graph_new = instance_new->graph();
+
+    RecolorOutput output(instance_new);
+    output.vertex_ids = vertex_ids;
+    AlgorithmFormatter algorithm_formatter(parameters, output);
+    algorithm_formatter.start("Recoloring");
+    algorithm_formatter.print_header();
+    algorithm_formatter.update_clique_bound();
+
+    // Keep the colors of the remaining vertices.
+    // Colors are renumbered from 0, since the ids of the colors must be
+    // smaller than the number of vertices.
+    Solution solution_new(*instance_new);
+    std::vector<ColorId> color_ids(number_of_vertices_old, -1);
+    ColorId number_of_colors = 0;
+    for (VertexId original_vertex_id = 0;
+            original_vertex_id < number_of_vertices_old;
+            ++original_vertex_id) {
+        if (vertex_ids[original_vertex_id] == -1)
+            continue;
+        VertexId vertex_id = instance.vertex_id(original_vertex_id);
+        if (!solution.contains(vertex_id))
+            continue;
+        ColorId color_id = solution.color(vertex_id);
+        if (color_ids[color_id] == -1)
+            color_ids[color_id] = number_of_colors++;
+        solution_new.set(vertex_ids[original_vertex_id], color_ids[color_id]);
+    }
+
+    // Uncolor the end with the most conflicts of each conflicting edge.
+    while (solution_new.number_of_conflicts() > 0) {
+        EdgeId edge_id = solution_new.conflict(0);
+        VertexId vertex_id_1 = instance_new->adjacency_list_graph()->first_end(edge_id);
+        VertexId vertex_id_2 = instance_new->adjacency_list_graph()->second_end(edge_id);
+        VertexId vertex_id = (solution_new.conflicting_vertices()[vertex_id_1]
+                >= solution_new.conflicting_vertices()[vertex_id_2])?
+            vertex_id_1: vertex_id_2;
+        solution_new.set(vertex_id, -1);
+    }
+
+    // Color the uncolored vertices by non-increasing degree.
+    std::vector<VertexId> uncolored_vertices;
+    for (VertexId vertex_id = 0; vertex_id < number_of_vertices; ++vertex_id)
+        if (!solution_new.contains(vertex_id))
+            uncolored_vertices.push_back(vertex_id);
+    std::sort(
+            uncolored_vertices.begin(),
+            uncolored_vertices.end(),
+            [&graph_new](VertexId vertex_id_1, VertexId vertex_id_2)
+            {
+                return graph_new.degree(vertex_id_1) > graph_new.degree(vertex_id_2);
+            });
+    ColorAvailability color_availability(number_of_vertices);
+    RecolorKempeChainBuffers buffers(number_of_vertices);
+    for (VertexId vertex_id: uncolored_vertices) {
+        color_availability.clear();
+        auto it = graph_new.neighbors_begin(vertex_id);
+        auto it_end = graph_new.neighbors_end(vertex_id);
+        for (; it != it_end; ++it)
+            if (solution_new.contains(*it))
+                color_availability.forbid(solution_new.color(*it));
+        ColorId color_id = color_availability.first_available();
+        if (solution_new.number_of_vertices(color_id) == 0
+                && parameters.maximum_kempe_chain_size > 0) {
+            // All the colors used are taken by the neighbors.
+            ColorId color_id_kempe = recolor_kempe_chain_interchange(
+                    solution_new,
+                    vertex_id,
+                    parameters.maximum_kempe_chain_size,
+                    buffers);
+            if (color_id_kempe != -1) {
+                color_id = color_id_kempe;
+                output.number_of_kempe_chain_interchanges++;
+            }
+        }
+        solution_new.set(vertex_id, color_id);
+        output.number_of_recolored_vertices++;
+    }
+    algorithm_formatter.update_solution(solution_new, "repair");
+
+    // Improve the repaired solution.
+    if (parameters.local_search_maximum_number_of_iterations > 0
+            && instance_new->compact_graph() != nullptr
+            && !algorithm_formatter.optimal()) {
+        LocalSearchRowWeightingParameters local_search_parameters;
+        local_search_parameters.verbosity_level = 0;
+        local_search_parameters.clique_lower_bound = false;
+        local_search_parameters.goal = output.bound;
+        local_search_parameters.timer = parameters.timer;
+        local_search_parameters.maximum_number_of_iterations
+            = parameters.local_search_maximum_number_of_iterations;
+        local_search_parameters.initial_solution = &solution_new;
+        auto local_search_output = local_search_row_weighting(
+                *instance_new,
+                generator,
+                local_search_parameters);
+        algorithm_formatter.update_solution(
+                local_search_output.solution,
+                "local search");
+    }
+
+    algorithm_formatter.end();
+    return output;
+}
@@ -0,0 +1,154 @@
+#include "coloringsolver/clique.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+using namespace coloringsolver;
+
+namespace
+{
+
+/**
+ * Grow cliques from the vertices at positions 'start_pos', 'start_pos -
+ * step', 'start_pos - 2 * step'... of the degeneracy ordering.
+ */
+template <typename Graph>
+void greedy_clique_search(
+        const Instance& instance,
+        const Graph& graph,
+        const std::vector<VertexPos>& positions,
+        VertexPos start_pos,
+        VertexPos step,
+        std::atomic<VertexPos>& best_size,
+        std::mutex& mutex,
+        std::vector<VertexId>& best_clique,
+        const optimizationtools::Timer* timer)
+{
+    const std::vector<VertexId>& ordering = instance.degeneracy_ordering();
+    std::vector<Counter> marks(graph.number_of_vertices(), -1);
+    Counter mark = 0;
+    std::vector<VertexId> clique;
+    std::vector<VertexId> candidates;
+    for (VertexPos vertex_pos = start_pos;
+            vertex_pos >= 0;
+            vertex_pos -= step) {
+        if (timer != nullptr && timer->needs_to_end())
+            break;
+        VertexId vertex_id = ordering[vertex_pos];
+        // Core numbers are non-decreasing along the degeneracy ordering.
+        if (instance.core_number(vertex_id) + 1 <= best_size)
+            break;
+
+        clique.clear();
+        clique.push_back(vertex_id);
+        candidates.clear();
+        for (auto it = graph.neighbors_begin(vertex_id);
+                it != graph.neighbors_end(vertex_id);
+                ++it) {
+            if (positions[*it] > vertex_pos)
+                candidates.push_back(*it);
+        }
+        std::sort(
+                candidates.begin(),
+                candidates.end(),
+                [&positions](VertexId vertex_id_1, VertexId vertex_id_2)
+                {
+                    return positions[vertex_id_1] > positions[vertex_id_2];
+                });
+
+        while (!candidates.empty()
+                && (VertexPos)(clique.size() + candidates.size()) > best_size) {
+            VertexId vertex_id_added = candidates.front();
+            clique.push_back(vertex_id_added);
+            mark++;
+            for (auto it = graph.neighbors_begin(vertex_id_added);
+                    it != graph.neighbors_end(vertex_id_added);
+                    ++it) {
+                marks[*it] = mark;
+            }
+            VertexPos number_of_candidates = 0;
+            for (VertexId vertex_id_candidate: candidates)
+                if (marks[vertex_id_candidate] == mark)
+                    candidates[number_of_candidates++] = vertex_id_candidate;
+            candidates.resize(number_of_candidates);
+        }
+
+        if ((VertexPos)clique.size() > best_size) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if ((VertexPos)clique.size() > best_size) {
+                best_size = clique.size();
+                best_clique = clique;
+            }
+        }
+    }
+}
+
+template <typename Graph>
+std::vector<VertexId> greedy_clique(
+        const Instance& instance,
+        const Graph& graph,
+        Counter number_of_threads,
+        const optimizationtools::Timer* timer)
+{
+    const std::vector<VertexId>& ordering = instance.degeneracy_ordering();
+    VertexPos n = ordering.size();
+    std::vector<VertexPos> positions(n);
+    for (VertexPos vertex_pos = 0; vertex_pos < n; ++vertex_pos)
+        positions[ordering[vertex_pos]] = vertex_pos;
+
+    std::atomic<VertexPos> best_size(0);
+    std::mutex mutex;
+    std::vector<VertexId> best_clique;
+    if (number_of_threads == 1) {
+        greedy_clique_search(
+                instance,
+                graph,
+                positions,
+                n - 1,
+                1,
+                best_size,
+                mutex,
+                best_clique,
+                timer);
+        return best_clique;
+    }
+    std::vector<std::thread> threads;
+    for (Counter thread_id = 0; thread_id < number_of_threads; ++thread_id) {
+        threads.push_back(std::thread([&, thread_id]()
+        {
+            greedy_clique_search(
+                    instance,
+                    graph,
+                    positions,
+                    n - 1 - thread_id,
+                    number_of_threads,
+                    best_size,
+                    mutex,
+                    best_clique,
+                    timer);
+        }));
+    }
+    for (std::thread& thread: threads)
+        thread.join();
+    return best_clique;
+}
+
+}
+
+std::vector<VertexId> coloringsolver::greedy_clique(
+        const Instance& instance,
+        Counter number_of_threads,
+        const optimizationtools::Timer* timer)
+{
+    if (number_of_threads < 1) {
+        throw std::invalid_argument(
+                "The number of threads must be at least 1.");
+    }
+    if (instance.compact_graph() != nullptr) {
+        return ::greedy_clique(instance, *instance.compact_graph(), number_of_threads, timer);
+    } else {
+        return ::greedy_clique(instance, instance.graph(), number_of_threads, timer);
+    }
+}
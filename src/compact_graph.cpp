@@ -0,0 +1,57 @@
+#include "coloringsolver/compact_graph.hpp"
+
+#include <limits>
+
+using namespace coloringsolver;
+
+bool CompactGraph::fits(const optimizationtools::AdjacencyListGraph& graph)
+{
+    return graph.number_of_vertices() < std::numeric_limits<CompactVertexId>::max()
+        && graph.number_of_edges() < std::numeric_limits<CompactEdgeId>::max();
+}
+
+CompactGraph::CompactGraph(const optimizationtools::AdjacencyListGraph& graph):
+    number_of_vertices_(graph.number_of_vertices()),
+    number_of_edges_(graph.number_of_edges()),
+    highest_degree_(graph.highest_degree()),
+    offsets_storage_(graph.number_of_vertices() + 1, 0)
+{
+    for (optimizationtools::VertexId vertex_id = 0;
+            vertex_id < graph.number_of_vertices();
+            ++vertex_id) {
+        offsets_storage_[vertex_id + 1] = offsets_storage_[vertex_id] + graph.degree(vertex_id);
+    }
+    neighbors_storage_.resize(offsets_storage_.back());
+    edge_ids_storage_.resize(offsets_storage_.back());
+    for (optimizationtools::VertexId vertex_id = 0;
+            vertex_id < graph.number_of_vertices();
+            ++vertex_id) {
+        optimizationtools::EdgeId pos = offsets_storage_[vertex_id];
+        for (const auto& edge: graph.edges(vertex_id)) {
+            neighbors_storage_[pos] = edge.vertex_id;
+            edge_ids_storage_[pos] = edge.edge_id;
+            ++pos;
+        }
+    }
+    offsets_ = offsets_storage_.data();
+    neighbors_ = neighbors_storage_.data();
+    edge_ids_ = edge_ids_storage_.data();
+}
+
+CompactGraph::CompactGraph(
+        optimizationtools::VertexId number_of_vertices,
+        optimizationtools::EdgeId number_of_edges,
+        optimizationtools::VertexId highest_degree,
+        const optimizationtools::EdgeId* offsets,
+        const CompactVertexId* neighbors,
+        const CompactEdgeId* edge_ids,
+        const std::shared_ptr<const void>& buffer):
+    number_of_vertices_(number_of_vertices),
+    number_of_edges_(number_of_edges),
+    highest_degree_(highest_degree),
+    offsets_(offsets),
+    neighbors_(neighbors),
+    edge_ids_(edge_ids),
+    buffer_(buffer)
+{
+}
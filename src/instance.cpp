@@ -2,43 +2,902 @@
 
 #include "optimizationtools/graph/clique_graph.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <fstream>
 #include <iomanip>
+#include <limits>
+#include <thread>
+
+#if defined(_WIN32)
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 using namespace coloringsolver;
 
+std::istream& coloringsolver::operator>>(
+        std::istream& in,
+        VertexRelabeling& vertex_relabeling)
+{
+    std::string token;
+    in >> token;
+    if (token == "none") {
+        vertex_relabeling = VertexRelabeling::None;
+    } else if (token == "reverse-cuthill-mckee" || token == "rcm") {
+        vertex_relabeling = VertexRelabeling::ReverseCuthillMcKee;
+    } else if (token == "degree-descending" || token == "degree") {
+        vertex_relabeling = VertexRelabeling::DegreeDescending;
+    } else if (token == "breadth-first-search" || token == "bfs") {
+        vertex_relabeling = VertexRelabeling::BreadthFirstSearch;
+    } else  {
+        in.setstate(std::ios_base::failbit);
+    }
+    return in;
+}
+
+std::ostream& coloringsolver::operator<<(
+        std::ostream &os,
+        VertexRelabeling vertex_relabeling)
+{
+    switch (vertex_relabeling) {
+    case VertexRelabeling::None: {
+        os << "none";
+        break;
+    } case VertexRelabeling::ReverseCuthillMcKee: {
+        os << "reversecuthillmckee";
+        break;
+    } case VertexRelabeling::DegreeDescending: {
+        os << "degreedescending";
+        break;
+    } case VertexRelabeling::BreadthFirstSearch: {
+        os << "breadthfirstsearch";
+        break;
+    }
+    }
+    return os;
+}
+
+namespace
+{
+
+/**
+ * Header of the binary graph format.
+ *
+ * The header is followed by the sections of the file, each of them padded to
+ * a multiple of 8 bytes:
+ * - the offsets of the compact graph ('number_of_vertices + 1' 64-bit integers)
+ * - the neighbors of the compact graph ('2 * number_of_edges' 32-bit integers)
+ * - the edges of the compact graph ('2 * number_of_edges' 32-bit integers)
+ * - the two ends of each edge ('2 * number_of_edges' 32-bit integers)
+ * - the weight of each vertex ('number_of_vertices' 64-bit floating point
+ *   numbers)
+ * - if 'relabeled' is not 0, the original id of each vertex
+ *   ('number_of_vertices' 64-bit integers)
+ *
+ * Integers are stored with the byte order of the machine which wrote the
+ * file.
+ */
+struct BinaryGraphHeader
+{
+    char magic[8];
+    uint64_t number_of_vertices;
+    uint64_t number_of_edges;
+    uint64_t highest_degree;
+    uint64_t relabeled;
+};
+
+const char binary_graph_magic[8] = {'C', 'O', 'L', 'G', 'R', 'P', 'H', '2'};
+
+inline std::size_t binary_graph_align(std::size_t size)
+{
+    return (size + 7) / 8 * 8;
+}
+
+/** Throw an exception if a binary graph file is inconsistent. */
+inline void binary_graph_check(
+        bool condition,
+        const std::string& instance_path)
+{
+    if (!condition) {
+        throw std::runtime_error(
+                "Binary graph file \"" + instance_path + "\" is corrupted.");
+    }
+}
+
+/** Positions of the sections of a binary graph file. */
+struct BinaryGraphLayout
+{
+    BinaryGraphLayout(
+            VertexId number_of_vertices,
+            EdgeId number_of_edges,
+            bool relabeled)
+    {
+        offsets_pos = binary_graph_align(sizeof(BinaryGraphHeader));
+        neighbors_pos = offsets_pos + binary_graph_align((number_of_vertices + 1) * sizeof(EdgeId));
+        edge_ids_pos = neighbors_pos + binary_graph_align(2 * number_of_edges * sizeof(CompactVertexId));
+        edge_ends_pos = edge_ids_pos + binary_graph_align(2 * number_of_edges * sizeof(CompactEdgeId));
+        weights_pos = edge_ends_pos + binary_graph_align(2 * number_of_edges * sizeof(CompactVertexId));
+        original_vertex_ids_pos = weights_pos + binary_graph_align(number_of_vertices * sizeof(double));
+        size = original_vertex_ids_pos + ((relabeled)? binary_graph_align(number_of_vertices * sizeof(VertexId)): 0);
+    }
+
+    std::size_t offsets_pos;
+    std::size_t neighbors_pos;
+    std::size_t edge_ids_pos;
+    std::size_t edge_ends_pos;
+    std::size_t weights_pos;
+    std::size_t original_vertex_ids_pos;
+    std::size_t size;
+};
+
+/**
+ * Map a file in memory.
+ *
+ * On systems without 'mmap', the file is read into a buffer instead. The
+ * buffer is 'nullptr' if the file is empty.
+ */
+std::shared_ptr<const void> instance_map_file(
+        const std::string& path,
+        std::size_t& size)
+{
+#if defined(_WIN32)
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.good()) {
+        throw std::runtime_error(
+                "Unable to open file \"" + path + "\".");
+    }
+    size = file.tellg();
+    if (size == 0)
+        return nullptr;
+    // The buffer is made of 64-bit integers so that the sections are
+    // aligned.
+    std::shared_ptr<uint64_t> buffer(
+            new uint64_t[(size + 7) / 8],
+            std::default_delete<uint64_t[]>());
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(buffer.get()), size);
+    return buffer;
+#else
+    int file_descriptor = open(path.c_str(), O_RDONLY);
+    if (file_descriptor == -1) {
+        throw std::runtime_error(
+                "Unable to open file \"" + path + "\".");
+    }
+    struct stat file_status;
+    if (fstat(file_descriptor, &file_status) == -1) {
+        close(file_descriptor);
+        throw std::runtime_error(
+                "Unable to read file \"" + path + "\".");
+    }
+    size = file_status.st_size;
+    // An empty file can't be mapped.
+    if (size == 0) {
+        close(file_descriptor);
+        return nullptr;
+    }
+    void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    close(file_descriptor);
+    if (address == MAP_FAILED) {
+        throw std::runtime_error(
+                "Unable to map file \"" + path + "\".");
+    }
+    return std::shared_ptr<const void>(
+            address,
+            [size](const void* address)
+            {
+                munmap(const_cast<void*>(address), size);
+            });
+#endif
+}
+
+/** Get the beginning of the line following the one of 'position'. */
+inline const char* reader_next_line(
+        const char* position,
+        const char* end)
+{
+    const char* new_line = static_cast<const char*>(
+            std::memchr(position, '\n', end - position));
+    return (new_line == nullptr)? end: new_line + 1;
+}
+
+/**
+ * Parse a non-negative integer preceded by spaces.
+ *
+ * Return 'false' if there is no integer before the end of the line.
+ */
+inline bool reader_parse_integer(
+        const char*& position,
+        const char* end,
+        VertexId& value)
+{
+    while (position < end && (*position == ' ' || *position == '\t'))
+        ++position;
+    if (position == end || *position < '0' || *position > '9')
+        return false;
+    value = 0;
+    while (position < end && *position >= '0' && *position <= '9') {
+        value = 10 * value + (*position - '0');
+        ++position;
+    }
+    return true;
+}
+
+/**
+ * Sort the vertices by non-decreasing degree with a bucket sort.
+ *
+ * Vertices with the same degree are sorted by id.
+ */
+std::vector<VertexId> relabeling_sort_by_degree(
+        const optimizationtools::AbstractGraph& graph)
+{
+    VertexId n = graph.number_of_vertices();
+    std::vector<VertexPos> bucket_starts(graph.highest_degree() + 2, 0);
+    for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id)
+        bucket_starts[graph.degree(vertex_id) + 1]++;
+    for (VertexPos degree = 0; degree <= graph.highest_degree(); ++degree)
+        bucket_starts[degree + 1] += bucket_starts[degree];
+    std::vector<VertexId> sorted_vertices(n);
+    for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id)
+        sorted_vertices[bucket_starts[graph.degree(vertex_id)]++] = vertex_id;
+    return sorted_vertices;
+}
+
+std::vector<VertexId> relabeling_degree_descending(
+        const optimizationtools::AbstractGraph& graph)
+{
+    std::vector<VertexId> sorted_vertices = relabeling_sort_by_degree(graph);
+    // Reverse the buckets but keep the vertices of a bucket sorted by id.
+    std::vector<VertexId> ordering;
+    ordering.reserve(sorted_vertices.size());
+    VertexPos bucket_end = sorted_vertices.size();
+    while (bucket_end > 0) {
+        VertexPos bucket_start = bucket_end - 1;
+        VertexPos degree = graph.degree(sorted_vertices[bucket_start]);
+        while (bucket_start > 0
+                && graph.degree(sorted_vertices[bucket_start - 1]) == degree) {
+            bucket_start--;
+        }
+        ordering.insert(
+                ordering.end(),
+                sorted_vertices.begin() + bucket_start,
+                sorted_vertices.begin() + bucket_end);
+        bucket_end = bucket_start;
+    }
+    return ordering;
+}
+
+std::vector<VertexId> relabeling_breadth_first_search(
+        const optimizationtools::AbstractGraph& graph)
+{
+    VertexId n = graph.number_of_vertices();
+    std::vector<uint8_t> visited(n, 0);
+    std::vector<VertexId> ordering;
+    ordering.reserve(n);
+    for (VertexId vertex_id_root = 0; vertex_id_root < n; ++vertex_id_root) {
+        if (visited[vertex_id_root])
+            continue;
+        visited[vertex_id_root] = 1;
+        ordering.push_back(vertex_id_root);
+        // 'ordering' is used as the queue of the search.
+        for (VertexPos vertex_pos = ordering.size() - 1;
+                vertex_pos < (VertexPos)ordering.size();
+                ++vertex_pos) {
+            VertexId vertex_id = ordering[vertex_pos];
+            auto it = graph.neighbors_begin(vertex_id);
+            auto it_end = graph.neighbors_end(vertex_id);
+            for (; it != it_end; ++it) {
+                VertexId vertex_id_neighbor = *it;
+                if (visited[vertex_id_neighbor])
+                    continue;
+                visited[vertex_id_neighbor] = 1;
+                ordering.push_back(vertex_id_neighbor);
+            }
+        }
+    }
+    return ordering;
+}
+
+/**
+ * Compute a reverse Cuthill-McKee ordering.
+ *
+ * Each connected component is searched in breadth-first order from its vertex
+ * of smallest degree, the unvisited neighbors of a vertex being visited by
+ * non-decreasing degree. The ordering is then reversed.
+ */
+std::vector<VertexId> relabeling_reverse_cuthill_mckee(
+        const optimizationtools::AbstractGraph& graph)
+{
+    VertexId n = graph.number_of_vertices();
+    std::vector<uint8_t> visited(n, 0);
+    std::vector<VertexId> ordering;
+    ordering.reserve(n);
+    std::vector<VertexId> neighbors;
+    for (VertexId vertex_id_root: relabeling_sort_by_degree(graph)) {
+        if (visited[vertex_id_root])
+            continue;
+        visited[vertex_id_root] = 1;
+        ordering.push_back(vertex_id_root);
+        for (VertexPos vertex_pos = ordering.size() - 1;
+                vertex_pos < (VertexPos)ordering.size();
+                ++vertex_pos) {
+            VertexId vertex_id = ordering[vertex_pos];
+            neighbors.clear();
+            auto it = graph.neighbors_begin(vertex_id);
+            auto it_end = graph.neighbors_end(vertex_id);
+            for (; it != it_end; ++it) {
+                VertexId vertex_id_neighbor = *it;
+                if (visited[vertex_id_neighbor])
+                    continue;
+                visited[vertex_id_neighbor] = 1;
+                neighbors.push_back(vertex_id_neighbor);
+            }
+            std::sort(
+                    neighbors.begin(),
+                    neighbors.end(),
+                    [&graph](VertexId vertex_id_1, VertexId vertex_id_2)
+                    {
+                        if (graph.degree(vertex_id_1) != graph.degree(vertex_id_2))
+                            return graph.degree(vertex_id_1) < graph.degree(vertex_id_2);
+                        return vertex_id_1 < vertex_id_2;
+                    });
+            ordering.insert(ordering.end(), neighbors.begin(), neighbors.end());
+        }
+    }
+    std::reverse(ordering.begin(), ordering.end());
+    return ordering;
+}
+
+}
+
+const optimizationtools::AdjacencyListGraph& BinaryAdjacencyListGraph::graph() const
+{
+    std::call_once(once_flag_, [this]()
+    {
+        // The edges are added in the order of their ids, so that the edge ids
+        // match the ones of the compact graph.
+        optimizationtools::AdjacencyListGraphBuilder graph_builder;
+        for (VertexId vertex_id = 0; vertex_id < number_of_vertices_; ++vertex_id)
+            graph_builder.add_vertex(weights_[vertex_id]);
+        for (EdgeId edge_id = 0; edge_id < number_of_edges_; ++edge_id)
+            graph_builder.add_edge(edge_ends_[2 * edge_id], edge_ends_[2 * edge_id + 1]);
+        graph_ = std::unique_ptr<const optimizationtools::AdjacencyListGraph>(
+                new optimizationtools::AdjacencyListGraph(graph_builder.build()));
+    });
+    return *graph_;
+}
+
 Instance::Instance(
         const std::string& instance_path,
-        const std::string& format)
+        const std::string& format,
+        const InstanceReadParameters& read_parameters)
 {
     if (format == "cliquegraph") {
         optimizationtools::CliqueGraphBuilder graph_builder;
         graph_builder.read(instance_path, format);
         graph_ = std::shared_ptr<const optimizationtools::AbstractGraph>(
                 new optimizationtools::CliqueGraph(graph_builder.build()));
+    } else if (format == "binary") {
+        read_binary(instance_path);
+        relabel(read_parameters.vertex_relabeling);
+    } else if (read_parameters.number_of_threads > 1
+            && (format == "snap"
+                || format == "matrixmarket"
+                || format == "dimacs")) {
+        read_parallel(instance_path, format, read_parameters);
+        relabel(read_parameters.vertex_relabeling);
     } else {
         optimizationtools::AdjacencyListGraphBuilder graph_builder;
         graph_builder.read(instance_path, format);
         graph_ = std::shared_ptr<const optimizationtools::AbstractGraph>(
                 new optimizationtools::AdjacencyListGraph(graph_builder.build()));
         adjacency_list_graph_ = static_cast<const optimizationtools::AdjacencyListGraph*>(graph_.get());
+        if (read_parameters.remove_duplicate_edges) {
+            std::vector<std::vector<VertexId>> edges(1);
+            edges[0].reserve(2 * adjacency_list_graph_->number_of_edges());
+            for (EdgeId edge_id = 0;
+                    edge_id < adjacency_list_graph_->number_of_edges();
+                    ++edge_id) {
+                edges[0].push_back(adjacency_list_graph_->first_end(edge_id));
+                edges[0].push_back(adjacency_list_graph_->second_end(edge_id));
+            }
+            build(adjacency_list_graph_->number_of_vertices(), edges, true);
+        }
+        relabel(read_parameters.vertex_relabeling);
     }
+    initialize();
 }
 
 Instance::Instance(const std::shared_ptr<const optimizationtools::AbstractGraph>& abstract_graph):
     graph_(abstract_graph),
-    adjacency_list_graph_(dynamic_cast<const optimizationtools::AdjacencyListGraph*>(graph_.get())) { }
+    adjacency_list_graph_(dynamic_cast<const optimizationtools::AdjacencyListGraph*>(graph_.get()))
+{
+    initialize();
+}
+
+void Instance::initialize()
+{
+    if (compact_graph_ == nullptr
+            && adjacency_list_graph_ != nullptr
+            && CompactGraph::fits(*adjacency_list_graph_)) {
+        compact_graph_ = std::make_shared<const CompactGraph>(*adjacency_list_graph_);
+    }
+    if (compact_graph_ != nullptr) {
+        compute_core_decomposition(*compact_graph_);
+    } else {
+        compute_core_decomposition(graph());
+    }
+}
+
+void Instance::relabel(VertexRelabeling vertex_relabeling)
+{
+    if (vertex_relabeling == VertexRelabeling::None)
+        return;
+    const optimizationtools::AdjacencyListGraph& graph = *adjacency_list_graph();
+    // ordering[vertex_id] is the current id of the vertex which gets id
+    // 'vertex_id'.
+    std::vector<VertexId> ordering;
+    switch (vertex_relabeling) {
+    case VertexRelabeling::None: {
+        return;
+    } case VertexRelabeling::ReverseCuthillMcKee: {
+        ordering = relabeling_reverse_cuthill_mckee(graph);
+        break;
+    } case VertexRelabeling::DegreeDescending: {
+        ordering = relabeling_degree_descending(graph);
+        break;
+    } case VertexRelabeling::BreadthFirstSearch: {
+        ordering = relabeling_breadth_first_search(graph);
+        break;
+    }
+    }
+
+    VertexId n = graph.number_of_vertices();
+    std::vector<VertexId> positions(n);
+    for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id)
+        positions[ordering[vertex_id]] = vertex_id;
+
+    // Build the relabeled graph.
+    // Edges are added by increasing smallest end, so that the edges of
+    // neighboring vertices also get close ids.
+    optimizationtools::AdjacencyListGraphBuilder graph_builder;
+    for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id)
+        graph_builder.add_vertex(graph.weight(ordering[vertex_id]));
+    for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id) {
+        auto it = graph.neighbors_begin(ordering[vertex_id]);
+        auto it_end = graph.neighbors_end(ordering[vertex_id]);
+        for (; it != it_end; ++it) {
+            VertexId vertex_id_neighbor = positions[*it];
+            if (vertex_id < vertex_id_neighbor)
+                graph_builder.add_edge(vertex_id, vertex_id_neighbor);
+        }
+    }
+
+    // Compose with the relabeling of the graph which has been read, if any.
+    std::vector<VertexId> original_vertex_ids(n);
+    for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id)
+        original_vertex_ids[vertex_id] = original_vertex_id(ordering[vertex_id]);
+    original_vertex_ids_.swap(original_vertex_ids);
+    vertex_ids_.resize(n);
+    for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id)
+        vertex_ids_[original_vertex_ids_[vertex_id]] = vertex_id;
+
+    graph_ = std::shared_ptr<const optimizationtools::AbstractGraph>(
+            new optimizationtools::AdjacencyListGraph(graph_builder.build()));
+    adjacency_list_graph_ = static_cast<const optimizationtools::AdjacencyListGraph*>(graph_.get());
+    binary_graph_ = nullptr;
+    compact_graph_ = nullptr;
+}
+
+void Instance::read_binary(const std::string& instance_path)
+{
+    std::size_t size = 0;
+    std::shared_ptr<const void> buffer = instance_map_file(instance_path, size);
+    const char* data = static_cast<const char*>(buffer.get());
+
+    BinaryGraphHeader header;
+    if (size < sizeof(header)
+            || std::memcmp(data, binary_graph_magic, sizeof(header.magic)) != 0) {
+        throw std::runtime_error(
+                "\"" + instance_path + "\" is not a binary graph file.");
+    }
+    std::memcpy(&header, data, sizeof(header));
+    binary_graph_check(
+            header.number_of_vertices < std::numeric_limits<CompactVertexId>::max()
+            && header.number_of_edges < std::numeric_limits<CompactEdgeId>::max(),
+            instance_path);
+    VertexId n = header.number_of_vertices;
+    EdgeId m = header.number_of_edges;
+    BinaryGraphLayout layout(n, m, header.relabeled);
+    if (size != layout.size) {
+        throw std::runtime_error(
+                "Binary graph file \"" + instance_path + "\" is truncated.");
+    }
+    const EdgeId* offsets = reinterpret_cast<const EdgeId*>(data + layout.offsets_pos);
+    const CompactVertexId* neighbors = reinterpret_cast<const CompactVertexId*>(data + layout.neighbors_pos);
+    const CompactEdgeId* edge_ids = reinterpret_cast<const CompactEdgeId*>(data + layout.edge_ids_pos);
+    const CompactVertexId* edge_ends = reinterpret_cast<const CompactVertexId*>(data + layout.edge_ends_pos);
+    const double* weights = reinterpret_cast<const double*>(data + layout.weights_pos);
+    const VertexId* original_vertex_ids = reinterpret_cast<const VertexId*>(data + layout.original_vertex_ids_pos);
+
+    // Check the arrays before using them, since their values are used as
+    // indices without bound checks. This is a single pass over the file.
+    binary_graph_check(offsets[0] == 0 && offsets[n] == 2 * m, instance_path);
+    VertexId highest_degree = 0;
+    for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id) {
+        binary_graph_check(offsets[vertex_id] <= offsets[vertex_id + 1], instance_path);
+        highest_degree = (std::max)(
+                highest_degree,
+                (VertexId)(offsets[vertex_id + 1] - offsets[vertex_id]));
+    }
+    binary_graph_check((uint64_t)highest_degree == header.highest_degree, instance_path);
+    for (EdgeId edge_id = 0; edge_id < m; ++edge_id) {
+        binary_graph_check(
+                edge_ends[2 * edge_id] < n
+                && edge_ends[2 * edge_id + 1] < n
+                && edge_ends[2 * edge_id] != edge_ends[2 * edge_id + 1],
+                instance_path);
+    }
+    // Each position of the compact graph must link a vertex to an end of an
+    // edge whose other end is the vertex.
+    for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id) {
+        for (EdgeId pos = offsets[vertex_id]; pos < offsets[vertex_id + 1]; ++pos) {
+            binary_graph_check(neighbors[pos] < n && edge_ids[pos] < m, instance_path);
+            const CompactVertexId* ends = edge_ends + 2 * edge_ids[pos];
+            binary_graph_check(
+                    (ends[0] == vertex_id && ends[1] == neighbors[pos])
+                    || (ends[1] == vertex_id && ends[0] == neighbors[pos]),
+                    instance_path);
+        }
+    }
+    if (header.relabeled) {
+        // The original ids must be a permutation.
+        std::vector<bool> seen(n, false);
+        for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id) {
+            VertexId original_vertex_id = original_vertex_ids[vertex_id];
+            binary_graph_check(
+                    original_vertex_id >= 0
+                    && original_vertex_id < n
+                    && !seen[original_vertex_id],
+                    instance_path);
+            seen[original_vertex_id] = true;
+        }
+    }
+
+    // The compact graph uses the mapped arrays directly.
+    compact_graph_ = std::make_shared<const CompactGraph>(
+            n,
+            m,
+            header.highest_degree,
+            offsets,
+            neighbors,
+            edge_ids,
+            buffer);
+
+    // The adjacency list graph is only built when it is needed.
+    binary_graph_ = std::make_shared<const BinaryAdjacencyListGraph>(
+            n,
+            m,
+            edge_ends,
+            weights,
+            buffer);
+
+    if (header.relabeled) {
+        original_vertex_ids_.assign(original_vertex_ids, original_vertex_ids + n);
+        vertex_ids_.resize(n);
+        for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id)
+            vertex_ids_[original_vertex_ids_[vertex_id]] = vertex_id;
+    }
+}
+
+void Instance::read_parallel(
+        const std::string& instance_path,
+        const std::string& format,
+        const InstanceReadParameters& read_parameters)
+{
+    std::size_t size = 0;
+    std::shared_ptr<const void> buffer = instance_map_file(instance_path, size);
+    const char* data = static_cast<const char*>(buffer.get());
+    const char* end = data + size;
+
+    // Read the header.
+    // 'body' is the beginning of the lines containing the edges.
+    VertexId number_of_vertices = -1;
+    VertexId first_vertex_id = 0;
+    const char* body = data;
+    if (format == "matrixmarket") {
+        // Skip the comments, then read the number of rows.
+        first_vertex_id = 1;
+        while (body < end && *body == '%')
+            body = reader_next_line(body, end);
+        const char* position = body;
+        if (!reader_parse_integer(position, end, number_of_vertices)) {
+            throw std::runtime_error(
+                    "Missing size line in file \"" + instance_path + "\".");
+        }
+        body = reader_next_line(body, end);
+    } else if (format == "dimacs") {
+        // Find the problem line 'p edge n m'.
+        first_vertex_id = 1;
+        while (body < end && *body != 'p')
+            body = reader_next_line(body, end);
+        if (body == end) {
+            throw std::runtime_error(
+                    "Missing problem line in file \"" + instance_path + "\".");
+        }
+        const char* position = body + 1;
+        while (position < end && (*position == ' ' || *position == '\t'))
+            ++position;
+        while (position < end && *position != ' ' && *position != '\t' && *position != '\n')
+            ++position;
+        if (!reader_parse_integer(position, end, number_of_vertices)) {
+            throw std::runtime_error(
+                    "Missing problem line in file \"" + instance_path + "\".");
+        }
+        body = reader_next_line(body, end);
+    }
+
+    // Split the body into chunks of lines and parse them in parallel.
+    // A line belongs to the chunk containing its first character.
+    Counter number_of_threads = read_parameters.number_of_threads;
+    std::vector<const char*> chunk_begins(number_of_threads + 1, end);
+    for (Counter thread_id = 0; thread_id < number_of_threads; ++thread_id) {
+        const char* position = body + (end - body) * thread_id / number_of_threads;
+        chunk_begins[thread_id] = (position == body)?
+            body: reader_next_line(position - 1, end);
+    }
+    std::vector<std::vector<VertexId>> edges(number_of_threads);
+    std::vector<VertexId> highest_vertex_ids(number_of_threads, -1);
+    std::vector<std::exception_ptr> exceptions(number_of_threads);
+    std::vector<std::thread> threads;
+    for (Counter thread_id = 0; thread_id < number_of_threads; ++thread_id) {
+        threads.push_back(std::thread([&, thread_id]()
+        {
+            try {
+                const char* chunk_end = chunk_begins[thread_id + 1];
+                std::vector<VertexId>& thread_edges = edges[thread_id];
+                VertexId& highest_vertex_id = highest_vertex_ids[thread_id];
+                for (const char* line = chunk_begins[thread_id];
+                        line < chunk_end;
+                        line = reader_next_line(line, chunk_end)) {
+                    const char* position = line;
+                    if (format == "dimacs") {
+                        if (*position != 'e')
+                            continue;
+                        ++position;
+                    } else if (*position == '#' || *position == '%') {
+                        continue;
+                    }
+                    VertexId vertex_id_1 = -1;
+                    VertexId vertex_id_2 = -1;
+                    if (!reader_parse_integer(position, chunk_end, vertex_id_1)
+                            || !reader_parse_integer(position, chunk_end, vertex_id_2)) {
+                        continue;
+                    }
+                    vertex_id_1 -= first_vertex_id;
+                    vertex_id_2 -= first_vertex_id;
+                    if (vertex_id_1 < 0 || vertex_id_2 < 0) {
+                        throw std::runtime_error(
+                                "Invalid vertex id in file \""
+                                + instance_path + "\".");
+                    }
+                    // Loops are ignored.
+                    if (vertex_id_1 == vertex_id_2)
+                        continue;
+                    thread_edges.push_back(vertex_id_1);
+                    thread_edges.push_back(vertex_id_2);
+                    highest_vertex_id = (std::max)(
+                            highest_vertex_id,
+                            (std::max)(vertex_id_1, vertex_id_2));
+                }
+            } catch (...) {
+                exceptions[thread_id] = std::current_exception();
+            }
+        }));
+    }
+    for (std::thread& thread: threads)
+        thread.join();
+    for (const std::exception_ptr& exception: exceptions)
+        if (exception)
+            std::rethrow_exception(exception);
+
+    VertexId highest_vertex_id = *std::max_element(
+            highest_vertex_ids.begin(),
+            highest_vertex_ids.end());
+    if (number_of_vertices == -1) {
+        number_of_vertices = highest_vertex_id + 1;
+    } else if (highest_vertex_id >= number_of_vertices) {
+        throw std::runtime_error(
+                "Invalid vertex id in file \"" + instance_path + "\".");
+    }
+    build(number_of_vertices, edges, read_parameters.remove_duplicate_edges);
+}
+
+void Instance::build(
+        VertexId number_of_vertices,
+        const std::vector<std::vector<VertexId>>& edges,
+        bool remove_duplicate_edges)
+{
+    optimizationtools::AdjacencyListGraphBuilder graph_builder;
+    for (VertexId vertex_id = 0; vertex_id < number_of_vertices; ++vertex_id)
+        graph_builder.add_vertex();
+    if (!remove_duplicate_edges) {
+        for (const std::vector<VertexId>& thread_edges: edges)
+            for (std::size_t pos = 0; pos < thread_edges.size(); pos += 2)
+                graph_builder.add_edge(thread_edges[pos], thread_edges[pos + 1]);
+    } else {
+        // Sort the edges by smallest end with a bucket sort, then sort the
+        // largest ends of each bucket to find the duplicates.
+        std::vector<EdgeId> bucket_starts(number_of_vertices + 1, 0);
+        for (const std::vector<VertexId>& thread_edges: edges) {
+            for (std::size_t pos = 0; pos < thread_edges.size(); pos += 2) {
+                VertexId vertex_id = (std::min)(thread_edges[pos], thread_edges[pos + 1]);
+                bucket_starts[vertex_id + 1]++;
+            }
+        }
+        for (VertexId vertex_id = 0; vertex_id < number_of_vertices; ++vertex_id)
+            bucket_starts[vertex_id + 1] += bucket_starts[vertex_id];
+        std::vector<VertexId> largest_ends(bucket_starts.back());
+        std::vector<EdgeId> bucket_ends(bucket_starts.begin(), bucket_starts.end() - 1);
+        for (const std::vector<VertexId>& thread_edges: edges) {
+            for (std::size_t pos = 0; pos < thread_edges.size(); pos += 2) {
+                VertexId vertex_id_1 = (std::min)(thread_edges[pos], thread_edges[pos + 1]);
+                VertexId vertex_id_2 = (std::max)(thread_edges[pos], thread_edges[pos + 1]);
+                largest_ends[bucket_ends[vertex_id_1]++] = vertex_id_2;
+            }
+        }
+        for (VertexId vertex_id = 0; vertex_id < number_of_vertices; ++vertex_id) {
+            auto it_begin = largest_ends.begin() + bucket_starts[vertex_id];
+            auto it_end = largest_ends.begin() + bucket_starts[vertex_id + 1];
+            std::sort(it_begin, it_end);
+            it_end = std::unique(it_begin, it_end);
+            for (auto it = it_begin; it != it_end; ++it)
+                graph_builder.add_edge(vertex_id, *it);
+        }
+    }
+    graph_ = std::shared_ptr<const optimizationtools::AbstractGraph>(
+            new optimizationtools::AdjacencyListGraph(graph_builder.build()));
+    adjacency_list_graph_ = static_cast<const optimizationtools::AdjacencyListGraph*>(graph_.get());
+}
+
+void Instance::write_binary(const std::string& instance_path) const
+{
+    if (compact_graph_ == nullptr) {
+        throw std::runtime_error(
+                "Only graphs stored as an AdjacencyListGraph with less than"
+                " 2^32 vertices and edges can be written in binary format.");
+    }
+    std::ofstream file(instance_path, std::ios::binary);
+    if (!file.good()) {
+        throw std::runtime_error(
+                "Unable to open file \"" + instance_path + "\".");
+    }
+
+    const CompactGraph& graph = *compact_graph_;
+    VertexId n = graph.number_of_vertices();
+    EdgeId m = graph.number_of_edges();
+    BinaryGraphLayout layout(n, m, relabeled());
+
+    BinaryGraphHeader header;
+    std::memcpy(header.magic, binary_graph_magic, sizeof(header.magic));
+    header.number_of_vertices = n;
+    header.number_of_edges = m;
+    header.highest_degree = graph.highest_degree();
+    header.relabeled = relabeled();
+
+    const optimizationtools::AdjacencyListGraph& edges_graph = *adjacency_list_graph();
+    std::vector<CompactVertexId> edge_ends(2 * m);
+    for (EdgeId edge_id = 0; edge_id < m; ++edge_id) {
+        edge_ends[2 * edge_id] = edges_graph.first_end(edge_id);
+        edge_ends[2 * edge_id + 1] = edges_graph.second_end(edge_id);
+    }
+    std::vector<double> weights(n);
+    for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id)
+        weights[vertex_id] = edges_graph.weight(vertex_id);
+
+    // Write a section and pad it to the next multiple of 8 bytes.
+    auto write_section = [&file](const void* section, std::size_t size)
+    {
+        const char padding[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        file.write(static_cast<const char*>(section), size);
+        file.write(padding, binary_graph_align(size) - size);
+    };
+    write_section(&header, sizeof(header));
+    write_section(graph.offsets(), (n + 1) * sizeof(EdgeId));
+    write_section(graph.neighbors(), 2 * m * sizeof(CompactVertexId));
+    write_section(graph.edge_ids(), 2 * m * sizeof(CompactEdgeId));
+    write_section(edge_ends.data(), 2 * m * sizeof(CompactVertexId));
+    write_section(weights.data(), n * sizeof(double));
+    if (relabeled())
+        write_section(original_vertex_ids_.data(), n * sizeof(VertexId));
+    if (!file.good()) {
+        throw std::runtime_error(
+                "Unable to write file \"" + instance_path + "\".");
+    }
+}
+
+template <typename Graph>
+void Instance::compute_core_decomposition(const Graph& graph)
+{
+    VertexId n = graph.number_of_vertices();
+    VertexPos highest_degree = graph.highest_degree();
+
+    // Sort the vertices by degree with a bucket sort.
+    // bucket_starts[d] is the position of the first vertex of degree 'd' in
+    // 'degeneracy_ordering_'.
+    core_numbers_.resize(n);
+    std::vector<VertexPos> bucket_starts(highest_degree + 2, 0);
+    for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id) {
+        core_numbers_[vertex_id] = graph.degree(vertex_id);
+        bucket_starts[core_numbers_[vertex_id] + 1]++;
+    }
+    for (VertexPos degree = 0; degree <= highest_degree; ++degree)
+        bucket_starts[degree + 1] += bucket_starts[degree];
+    degeneracy_ordering_.resize(n);
+    std::vector<VertexPos> positions(n);
+    {
+        std::vector<VertexPos> bucket_ends(bucket_starts);
+        for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id) {
+            VertexPos vertex_pos = bucket_ends[core_numbers_[vertex_id]]++;
+            degeneracy_ordering_[vertex_pos] = vertex_id;
+            positions[vertex_id] = vertex_pos;
+        }
+    }
+
+    // Peel the vertices in order.
+    for (VertexPos vertex_pos = 0; vertex_pos < n; ++vertex_pos) {
+        VertexId vertex_id = degeneracy_ordering_[vertex_pos];
+        auto it = graph.neighbors_begin(vertex_id);
+        auto it_end = graph.neighbors_end(vertex_id);
+        for (; it != it_end; ++it) {
+            VertexId vertex_id_neighbor = *it;
+            VertexPos degree = core_numbers_[vertex_id_neighbor];
+            if (degree <= core_numbers_[vertex_id])
+                continue;
+            // Move the neighbor to the front of its bucket and decrease its
+            // degree.
+            VertexPos vertex_pos_neighbor = positions[vertex_id_neighbor];
+            VertexPos vertex_pos_first = bucket_starts[degree];
+            VertexId vertex_id_first = degeneracy_ordering_[vertex_pos_first];
+            if (vertex_id_first != vertex_id_neighbor) {
+                degeneracy_ordering_[vertex_pos_neighbor] = vertex_id_first;
+                positions[vertex_id_first] = vertex_pos_neighbor;
+                degeneracy_ordering_[vertex_pos_first] = vertex_id_neighbor;
+                positions[vertex_id_neighbor] = vertex_pos_first;
+            }
+            bucket_starts[degree]++;
+            core_numbers_[vertex_id_neighbor]--;
+        }
+    }
+
+    // Count the vertices by core number.
+    VertexPos degeneracy = (n == 0)? 0: core_numbers_[degeneracy_ordering_.back()];
+    number_of_vertices_by_core_ = std::vector<VertexPos>(degeneracy + 2, 0);
+    for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id)
+        number_of_vertices_by_core_[core_numbers_[vertex_id] + 1]++;
+    for (VertexPos core = 0; core <= degeneracy; ++core)
+        number_of_vertices_by_core_[core + 1] += number_of_vertices_by_core_[core];
+}
 
 std::ostream& Instance::format(
         std::ostream& os,
         int verbosity_level) const
 {
     if (verbosity_level >= 1) {
+        // The density and the average degree are computed from the numbers
+        // of vertices and edges, so that the adjacency list graph of a binary
+        // file doesn't need to be built.
+        VertexId n = number_of_vertices();
+        EdgeId m = number_of_edges();
         os
-            << "Number of vertices:  " << graph().number_of_vertices() << std::endl
-            << "Number of edges:     " << graph().number_of_edges() << std::endl
-            << "Density:             " << graph().density() << std::endl
-            << "Average degree:      " << graph().average_degree() << std::endl
-            << "Highest degree:      " << graph().highest_degree() << std::endl
+            << "Number of vertices:  " << n << std::endl
+            << "Number of edges:     " << m << std::endl
+            << "Density:             " << ((n <= 1)? 0.0: (double)m * 2 / n / (n - 1)) << std::endl
+            << "Average degree:      " << ((n == 0)? 0.0: (double)m * 2 / n) << std::endl
+            << "Highest degree:      " << highest_degree() << std::endl
             ;
     }
 
@@ -94,30 +953,7 @@ std::ostream& Instance::format(
 
 std::vector<VertexId> Instance::compute_core(ColorId k) const
 {
-    std::vector<VertexId> removed_vertices;
-    std::vector<VertexPos> vertex_degrees(graph().number_of_vertices(), -1);
-    std::vector<VertexId> vertex_queue;
-    for (VertexId vertex_id = 0;
-            vertex_id < graph().number_of_vertices();
-            ++vertex_id) {
-        vertex_degrees[vertex_id] = graph().degree(vertex_id);
-        if (vertex_degrees[vertex_id] < k)
-            vertex_queue.push_back(vertex_id);
-    }
-    while (!vertex_queue.empty()) {
-        VertexId vertex_id = vertex_queue.back();
-        removed_vertices.push_back(vertex_id);
-        vertex_queue.pop_back();
-        for (auto it = graph().neighbors_begin(vertex_id);
-                it != graph().neighbors_end(vertex_id);
-                ++it) {
-            if (vertex_degrees[*it] < k)
-                continue;
-            vertex_degrees[*it]--;
-            if (vertex_degrees[*it] < k)
-                vertex_queue.push_back(*it);
-        }
-    }
-    //std::cout << "k " << k << " removed_vertices.size() " << removed_vertices.size() << std::endl;
-    return removed_vertices;
+    return std::vector<VertexId>(
+            degeneracy_ordering_.begin(),
+            degeneracy_ordering_.begin() + number_of_core_removed_vertices(k));
 }
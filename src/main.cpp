@@ -5,18 +5,52 @@
 
 #include <boost/program_options.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
 using namespace coloringsolver;
 
 namespace po = boost::program_options;
 
+/**
+ * Set the parameters common to all the algorithms.
+ *
+ * If 'new_solution_callback' is set, the algorithm runs silently and the
+ * callback is called instead of writing the output files. This is used by the
+ * batch and server modes.
+ */
 void read_args(
         Parameters& parameters,
-        const po::variables_map& vm)
+        const po::variables_map& vm,
+        const NewSolutionCallback& new_solution_callback)
 {
-    parameters.timer.set_sigint_handler();
-    parameters.messages_to_stdout = true;
     if (vm.count("time-limit"))
         parameters.timer.set_time_limit(vm["time-limit"].as<double>());
+    if (vm.count("clique-lower-bound"))
+        parameters.clique_lower_bound = vm["clique-lower-bound"].as<bool>();
+    if (vm.count("clique-lower-bound-number-of-threads")) {
+        parameters.clique_lower_bound_number_of_threads
+            = vm["clique-lower-bound-number-of-threads"].as<int>();
+    }
+
+    if (new_solution_callback) {
+        parameters.verbosity_level = 0;
+        parameters.messages_to_stdout = false;
+        parameters.new_solution_callback = new_solution_callback;
+        return;
+    }
+
+    parameters.timer.set_sigint_handler();
+    parameters.messages_to_stdout = true;
     if (vm.count("verbosity-level"))
         parameters.verbosity_level = vm["verbosity-level"].as<int>();
     if (vm.count("log"))
@@ -50,36 +84,52 @@ void read_args(
 
 Output run(
         const Instance& instance,
-        const po::variables_map& vm)
+        const po::variables_map& vm,
+        const NewSolutionCallback& new_solution_callback = nullptr)
 {
     std::mt19937_64 generator(0);
     if (vm.count("seed"))
         generator.seed(vm["seed"].as<Seed>());
-    Solution solution = (vm.count("initial-solution"))?
-            Solution(instance, vm["initial-solution"].as<std::string>()):
-            Solution(instance);
+
+    // Read initial solution.
+    // It may be partial or infeasible, the algorithms repair it.
+    std::unique_ptr<Solution> initial_solution;
+    if (vm.count("initial-solution")) {
+        initial_solution.reset(new Solution(
+                    instance,
+                    vm["initial-solution"].as<std::string>()));
+    }
 
     // Run algorithm.
     std::string algorithm = vm["algorithm"].as<std::string>();
     if (algorithm == "greedy") {
         GreedyParameters parameters;
-        read_args(parameters, vm);
+        read_args(parameters, vm, new_solution_callback);
         if (vm.count("ordering"))
             parameters.ordering = vm["ordering"].as<Ordering>();
         if (vm.count("reverse"))
             parameters.reverse = vm["reverse"].as<bool>();
+        if (vm.count("number-of-threads"))
+            parameters.number_of_threads = vm["number-of-threads"].as<int>();
         return greedy(instance, parameters);
     } else if (algorithm == "greedy-dsatur"
             || algorithm == "dsatur") {
-        Parameters parameters;
-        read_args(parameters, vm);
+        GreedyDsaturParameters parameters;
+        read_args(parameters, vm, new_solution_callback);
         return greedy_dsatur(instance, parameters);
+    } else if (algorithm == "greedy-jones-plassmann") {
+        GreedyJonesPlassmannParameters parameters;
+        read_args(parameters, vm, new_solution_callback);
+        if (vm.count("number-of-threads"))
+            parameters.number_of_threads = vm["number-of-threads"].as<int>();
+        return greedy_jones_plassmann(instance, generator, parameters);
     } else if (algorithm == "milp-assignment") {
 #ifdef XPRESS_FOUND
         XPRSinit(NULL);
 #endif
         MilpAssignmentParameters parameters;
-        read_args(parameters, vm);
+        read_args(parameters, vm, new_solution_callback);
+        parameters.initial_solution = initial_solution.get();
         if (vm.count("solver"))
             parameters.solver = vm["solver"].as<mathoptsolverscmake::SolverName>();
         if (vm.count("break-symmetries"))
@@ -94,7 +144,8 @@ Output run(
         XPRSinit(NULL);
 #endif
         MilpParameters parameters;
-        read_args(parameters, vm);
+        read_args(parameters, vm, new_solution_callback);
+        parameters.initial_solution = initial_solution.get();
         if (vm.count("solver"))
             parameters.solver = vm["solver"].as<mathoptsolverscmake::SolverName>();
         auto output = milp_representatives(instance, parameters);
@@ -107,7 +158,8 @@ Output run(
         XPRSinit(NULL);
 #endif
         MilpPartialOrderingParameters parameters;
-        read_args(parameters, vm);
+        read_args(parameters, vm, new_solution_callback);
+        parameters.initial_solution = initial_solution.get();
         if (vm.count("solver"))
             parameters.solver = vm["solver"].as<mathoptsolverscmake::SolverName>();
         if (vm.count("hybrid"))
@@ -119,7 +171,8 @@ Output run(
         return output;
     } else if (algorithm == "local-search-row-weighting") {
         LocalSearchRowWeightingParameters parameters;
-        read_args(parameters, vm);
+        read_args(parameters, vm, new_solution_callback);
+        parameters.initial_solution = initial_solution.get();
         if (vm.count("maximum-number-of-iterations")) {
             parameters.maximum_number_of_iterations
                 = vm["maximum-number-of-iterations"].as<int>();
@@ -128,10 +181,15 @@ Output run(
             parameters.maximum_number_of_iterations_without_improvement
                 = vm["maximum-number-of-iterations-without-improvement"].as<int>();
         }
+        if (vm.count("penalty-decay-threshold")) {
+            parameters.penalty_decay_threshold
+                = vm["penalty-decay-threshold"].as<int>();
+        }
         return local_search_row_weighting(instance, generator, parameters);
     } else if (algorithm == "local-search-row-weighting-2") {
         LocalSearchRowWeighting2Parameters parameters;
-        read_args(parameters, vm);
+        read_args(parameters, vm, new_solution_callback);
+        parameters.initial_solution = initial_solution.get();
         if (vm.count("maximum-number-of-iterations")) {
             parameters.maximum_number_of_iterations
                 = vm["maximum-number-of-iterations"].as<int>();
@@ -140,22 +198,55 @@ Output run(
             parameters.maximum_number_of_iterations_without_improvement
                 = vm["maximum-number-of-iterations-without-improvement"].as<int>();
         }
+        if (vm.count("penalty-decay-threshold")) {
+            parameters.penalty_decay_threshold
+                = vm["penalty-decay-threshold"].as<int>();
+        }
         return local_search_row_weighting_2(instance, generator, parameters);
+    } else if (algorithm == "local-search-row-weighting-portfolio") {
+        LocalSearchRowWeightingPortfolioParameters parameters;
+        read_args(parameters, vm, new_solution_callback);
+        parameters.initial_solution = initial_solution.get();
+        if (vm.count("number-of-threads"))
+            parameters.number_of_threads = vm["number-of-threads"].as<int>();
+        if (vm.count("maximum-number-of-iterations")) {
+            parameters.maximum_number_of_iterations
+                = vm["maximum-number-of-iterations"].as<int>();
+        }
+        if (vm.count("maximum-number-of-iterations-without-improvement")) {
+            parameters.maximum_number_of_iterations_without_improvement
+                = vm["maximum-number-of-iterations-without-improvement"].as<int>();
+        }
+        if (vm.count("penalty-decay-threshold")) {
+            parameters.penalty_decay_threshold
+                = vm["penalty-decay-threshold"].as<int>();
+        }
+        return local_search_row_weighting_portfolio(instance, generator, parameters);
     } else if (algorithm == "column-generation-greedy") {
         ColumnGenerationParameters parameters;
-        read_args(parameters, vm);
+        read_args(parameters, vm, new_solution_callback);
+        parameters.initial_solution = initial_solution.get();
         if (vm.count("linear-programming-solver")) {
             parameters.linear_programming_solver
                 = vm["linear-programming-solver"].as<columngenerationsolver::SolverName>();
         }
+        if (vm.count("maximum-number-of-columns-per-pricing")) {
+            parameters.maximum_number_of_columns_per_pricing
+                = vm["maximum-number-of-columns-per-pricing"].as<int>();
+        }
         return column_generation_heuristic_greedy(instance, parameters);
     } else if (algorithm == "column-generation-limited-discrepancy-search") {
         ColumnGenerationParameters parameters;
-        read_args(parameters, vm);
+        read_args(parameters, vm, new_solution_callback);
+        parameters.initial_solution = initial_solution.get();
         if (vm.count("linear-programming-solver")) {
             parameters.linear_programming_solver
                 = vm["linear-programming-solver"].as<columngenerationsolver::SolverName>();
         }
+        if (vm.count("maximum-number-of-columns-per-pricing")) {
+            parameters.maximum_number_of_columns_per_pricing
+                = vm["maximum-number-of-columns-per-pricing"].as<int>();
+        }
         return column_generation_heuristic_limited_discrepancy_search(instance, parameters);
 
     } else {
@@ -164,17 +255,434 @@ Output run(
     }
 }
 
-int main(int argc, char *argv[])
+InstanceReadParameters read_instance_args(const po::variables_map& vm)
+{
+    InstanceReadParameters read_parameters;
+    if (vm.count("relabeling"))
+        read_parameters.vertex_relabeling = vm["relabeling"].as<VertexRelabeling>();
+    read_parameters.remove_duplicate_edges = vm.count("remove-duplicate-edges");
+    if (vm.count("number-of-reading-threads"))
+        read_parameters.number_of_threads = vm["number-of-reading-threads"].as<int>();
+    return read_parameters;
+}
+
+/**
+ * Split a line of a CSV file.
+ *
+ * Fields are not quoted in the manifests of the 'data' directory.
+ */
+std::vector<std::string> split_csv_line(const std::string& line)
+{
+    std::vector<std::string> fields;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, ','))
+        fields.push_back(field);
+    if (!line.empty() && line.back() == ',')
+        fields.push_back("");
+    return fields;
+}
+
+/**
+ * Run the algorithm on all the instances of a manifest.
+ *
+ * The manifest is a CSV file in the format of the files of the 'data'
+ * directory. Only its 'Path', 'Format' and 'Options' columns are used. The
+ * instances are solved in parallel, each of them by a single worker, and the
+ * outputs of all the instances are written in a single JSON file.
+ */
+void run_batch(const po::variables_map& vm)
+{
+    std::string manifest_path = vm["batch"].as<std::string>();
+    std::ifstream file(manifest_path);
+    if (!file.good()) {
+        throw std::runtime_error(
+                "Unable to open file \"" + manifest_path + "\".");
+    }
+
+    // Instance paths are relative to the directory of the manifest by
+    // default.
+    std::string data_directory = ".";
+    if (vm.count("batch-data-directory")) {
+        data_directory = vm["batch-data-directory"].as<std::string>();
+    } else {
+        std::size_t pos = manifest_path.find_last_of("/\\");
+        if (pos != std::string::npos)
+            data_directory = manifest_path.substr(0, pos);
+    }
+
+    // Read the manifest.
+    std::string line;
+    std::getline(file, line);
+    std::vector<std::string> header = split_csv_line(line);
+    auto column = [&header](const std::string& name)
+    {
+        auto it = std::find(header.begin(), header.end(), name);
+        return (it == header.end())? -1: (int)(it - header.begin());
+    };
+    int path_column = column("Path");
+    int format_column = column("Format");
+    int options_column = column("Options");
+    if (path_column == -1) {
+        throw std::runtime_error(
+                "Missing 'Path' column in file \"" + manifest_path + "\".");
+    }
+    std::vector<std::vector<std::string>> rows;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.empty())
+            continue;
+        std::vector<std::string> row = split_csv_line(line);
+        row.resize(header.size());
+        rows.push_back(row);
+    }
+
+    int number_of_threads = (vm.count("batch-number-of-threads"))?
+        vm["batch-number-of-threads"].as<int>():
+        (std::max)((int)std::thread::hardware_concurrency(), 1);
+    std::string certificate_directory = (vm.count("batch-certificate-directory"))?
+        vm["batch-certificate-directory"].as<std::string>(): "";
+
+    // Solve the instances.
+    std::vector<nlohmann::json> outputs(rows.size());
+    std::atomic<std::size_t> next_row_id(0);
+    std::mutex stdout_mutex;
+    auto worker = [&]()
+    {
+        for (;;) {
+            std::size_t row_id = next_row_id++;
+            if (row_id >= rows.size())
+                break;
+            const std::vector<std::string>& row = rows[row_id];
+            const std::string& instance_path = row[path_column];
+            std::string format = (format_column != -1 && !row[format_column].empty())?
+                row[format_column]: "dimacs";
+            InstanceReadParameters read_parameters = read_instance_args(vm);
+            read_parameters.number_of_threads = 1;
+            if (options_column != -1
+                    && row[options_column].find("--remove-duplicate-edges") != std::string::npos) {
+                read_parameters.remove_duplicate_edges = true;
+            }
+
+            std::string value;
+            try {
+                const Instance instance(
+                        data_directory + "/" + instance_path,
+                        format,
+                        read_parameters);
+                Output output = run(
+                        instance,
+                        vm,
+                        [](const Output&, const std::string&) { });
+                if (!certificate_directory.empty()) {
+                    std::string certificate_name = instance_path;
+                    std::replace(certificate_name.begin(), certificate_name.end(), '/', '_');
+                    std::replace(certificate_name.begin(), certificate_name.end(), '\\', '_');
+                    output.solution.write(
+                            certificate_directory + "/" + certificate_name + "_solution.txt");
+                }
+                outputs[row_id] = {
+                    {"Path", instance_path},
+                    {"Output", output.to_json()}};
+                value = output.solution_value();
+            } catch (const std::exception& e) {
+                outputs[row_id] = {
+                    {"Path", instance_path},
+                    {"Error", e.what()}};
+                value = std::string("error: ") + e.what();
+            }
+
+            std::lock_guard<std::mutex> lock(stdout_mutex);
+            std::cout << instance_path << "  " << value << std::endl;
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int thread_id = 0; thread_id < number_of_threads; ++thread_id)
+        threads.push_back(std::thread(worker));
+    for (std::thread& thread: threads)
+        thread.join();
+
+    if (vm.count("output")) {
+        std::string json_output_path = vm["output"].as<std::string>();
+        std::ofstream json_file(json_output_path);
+        if (!json_file.good()) {
+            throw std::runtime_error(
+                    "Unable to open file \"" + json_output_path + "\".");
+        }
+        json_file << std::setw(4) << nlohmann::json {{"Instances", outputs}} << std::endl;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////// Server ////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+po::options_description program_options();
+
+/**
+ * Server reading requests as line-delimited JSON on stdin and writing events
+ * as line-delimited JSON on stdout.
+ *
+ * A request is a JSON object such as:
+ *
+ *     {"id": 1, "arguments": "--algorithm greedy-dsatur --time-limit 10",
+ *      "instance": {"path": "data/dimacs1992/anna.col", "format": "dimacs"}}
+ *
+ * The instance can also be given by its edges:
+ *
+ *     "instance": {"number_of_vertices": 3, "edges": [[0, 1], [1, 2]]}
+ *
+ * 'arguments' accepts the same algorithm options as the command line. For each
+ * request, a "solution" event is written each time the algorithm finds a new
+ * best solution, then an "end" event with the output and the color of each
+ * vertex, or an "error" event. Requests are solved in parallel by the workers
+ * of the server, and the last 'cache_size' instances read from a file are
+ * kept in memory for the next requests on the same file.
+ */
+class Server
+{
+
+public:
+
+    /** Constructor. */
+    Server(
+            const po::variables_map& vm,
+            int number_of_threads,
+            int cache_size):
+        vm_(vm),
+        number_of_threads_(number_of_threads),
+        cache_size_(cache_size) { }
+
+    /** Serve the requests until the end of stdin. */
+    void serve()
+    {
+        std::vector<std::thread> threads;
+        for (int thread_id = 0; thread_id < number_of_threads_; ++thread_id)
+            threads.push_back(std::thread(&Server::work, this));
+
+        std::string line;
+        while (std::getline(std::cin, line)) {
+            if (line.empty())
+                continue;
+            std::lock_guard<std::mutex> lock(requests_mutex_);
+            requests_.push_back(line);
+            requests_condition_.notify_one();
+        }
+        {
+            std::lock_guard<std::mutex> lock(requests_mutex_);
+            end_of_input_ = true;
+            requests_condition_.notify_all();
+        }
+        for (std::thread& thread: threads)
+            thread.join();
+    }
+
+private:
+
+    /** Write an event. */
+    void write(const nlohmann::json& event)
+    {
+        std::lock_guard<std::mutex> lock(stdout_mutex_);
+        std::cout << event.dump() << std::endl;
+    }
+
+    /** Process requests until the end of the input. */
+    void work()
+    {
+        for (;;) {
+            std::string line;
+            {
+                std::unique_lock<std::mutex> lock(requests_mutex_);
+                requests_condition_.wait(lock, [this]() {
+                        return !requests_.empty() || end_of_input_; });
+                if (requests_.empty())
+                    return;
+                line = std::move(requests_.front());
+                requests_.pop_front();
+            }
+
+            nlohmann::json id = nullptr;
+            try {
+                nlohmann::json request = nlohmann::json::parse(line);
+                if (request.contains("id"))
+                    id = request["id"];
+                solve(id, request);
+            } catch (const std::exception& e) {
+                write({{"id", id}, {"event", "error"}, {"message", e.what()}});
+            }
+        }
+    }
+
+    /** Get the instance of a request. */
+    std::shared_ptr<const Instance> instance(
+            const nlohmann::json& json_instance,
+            const po::variables_map& vm)
+    {
+        if (json_instance.contains("edges")) {
+            VertexId number_of_vertices = json_instance.at("number_of_vertices").get<VertexId>();
+            optimizationtools::AdjacencyListGraphBuilder graph_builder;
+            for (VertexId vertex_id = 0; vertex_id < number_of_vertices; ++vertex_id)
+                graph_builder.add_vertex();
+            for (const nlohmann::json& edge: json_instance["edges"]) {
+                VertexId vertex_id_1 = edge.at(0).get<VertexId>();
+                VertexId vertex_id_2 = edge.at(1).get<VertexId>();
+                if (vertex_id_1 < 0 || vertex_id_1 >= number_of_vertices
+                        || vertex_id_2 < 0 || vertex_id_2 >= number_of_vertices) {
+                    throw std::invalid_argument("Invalid edge " + edge.dump() + ".");
+                }
+                graph_builder.add_edge(vertex_id_1, vertex_id_2);
+            }
+            return std::make_shared<const Instance>(
+                    std::shared_ptr<const optimizationtools::AbstractGraph>(
+                        new optimizationtools::AdjacencyListGraph(graph_builder.build())));
+        }
+
+        std::string instance_path = json_instance.at("path").get<std::string>();
+        std::string format = (json_instance.contains("format"))?
+            json_instance["format"].get<std::string>(): "dimacs";
+        std::string key = format + ":" + instance_path;
+        {
+            std::lock_guard<std::mutex> lock(instances_mutex_);
+            auto it = instance_positions_.find(key);
+            if (it != instance_positions_.end()) {
+                // Move the instance to the front of the cache.
+                instances_.splice(instances_.begin(), instances_, it->second);
+                return it->second->second;
+            }
+        }
+        // Several workers might read the same instance concurrently; the
+        // first one to finish is kept.
+        auto instance = std::make_shared<const Instance>(
+                instance_path,
+                format,
+                read_instance_args(vm));
+        std::lock_guard<std::mutex> lock(instances_mutex_);
+        auto it = instance_positions_.find(key);
+        if (it != instance_positions_.end())
+            return it->second->second;
+        if (cache_size_ == 0)
+            return instance;
+        // The requests being solved keep their instance alive when it is
+        // evicted.
+        instances_.push_front({key, instance});
+        instance_positions_[key] = instances_.begin();
+        if ((int)instances_.size() > cache_size_) {
+            instance_positions_.erase(instances_.back().first);
+            instances_.pop_back();
+        }
+        return instance;
+    }
+
+    /** Solve a request. */
+    void solve(
+            const nlohmann::json& id,
+            const nlohmann::json& request)
+    {
+        // Parse the algorithm options of the request.
+        std::string arguments = (request.contains("arguments"))?
+            request["arguments"].get<std::string>(): "";
+        po::variables_map vm;
+        po::store(
+                po::command_line_parser(po::split_unix(arguments))
+                .options(program_options())
+                .run(),
+                vm);
+        po::notify(vm);
+        if (!vm.count("algorithm"))
+            throw std::invalid_argument("Missing '--algorithm' in the arguments.");
+        if (vm.count("input") || vm.count("batch") || vm.count("serve")) {
+            throw std::invalid_argument(
+                    "'--input', '--batch' and '--serve' can't be used in a request.");
+        }
+        // The reading options of the server apply to the instances read from
+        // a file.
+        std::shared_ptr<const Instance> instance = this->instance(
+                request.at("instance"),
+                vm_);
+
+        Output output = run(
+                *instance,
+                vm,
+                [this, &id](
+                    const Output& output,
+                    const std::string& comment)
+                {
+                    write({
+                            {"id", id},
+                            {"event", "solution"},
+                            {"value", output.solution_value()},
+                            {"comment", comment},
+                            {"time", output.time}});
+                });
+
+        std::vector<ColorId> colors(instance->number_of_vertices(), -1);
+        for (VertexId original_vertex_id = 0;
+                original_vertex_id < instance->number_of_vertices();
+                ++original_vertex_id) {
+            VertexId vertex_id = instance->vertex_id(original_vertex_id);
+            if (output.solution.contains(vertex_id))
+                colors[original_vertex_id] = output.solution.color(vertex_id);
+        }
+        write({
+                {"id", id},
+                {"event", "end"},
+                {"output", output.to_json()},
+                {"colors", colors}});
+    }
+
+    /** Options of the server. */
+    const po::variables_map& vm_;
+
+    /** Number of workers. */
+    int number_of_threads_;
+
+    /** Maximum number of instances kept in 'instances_'. */
+    int cache_size_;
+
+    /** Mutex protecting stdout. */
+    std::mutex stdout_mutex_;
+
+    /** Requests waiting for a worker. */
+    std::deque<std::string> requests_;
+
+    /** Mutex protecting 'requests_' and 'end_of_input_'. */
+    std::mutex requests_mutex_;
+
+    /** Condition variable notified when a request arrives. */
+    std::condition_variable requests_condition_;
+
+    /** 'true' once stdin has been fully read. */
+    bool end_of_input_ = false;
+
+    /**
+     * Instances read from files with their format and path, from the most
+     * recently used one to the least recently used one.
+     */
+    std::list<std::pair<std::string, std::shared_ptr<const Instance>>> instances_;
+
+    /** Position in 'instances_' of each cached instance. */
+    std::map<std::string, std::list<std::pair<std::string, std::shared_ptr<const Instance>>>::iterator> instance_positions_;
+
+    /** Mutex protecting 'instances_' and 'instance_positions_'. */
+    std::mutex instances_mutex_;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////// Main /////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+po::options_description program_options()
 {
-    // Parse program options
     po::options_description desc("Allowed options");
     desc.add_options()
         ("help,h", "produce help message")
-        ("algorithm,a", po::value<std::string>()->required(), "set algorithm")
-        ("input,i", po::value<std::string>()->required(), "set input file (required)")
+        ("algorithm,a", po::value<std::string>(), "set algorithm (required unless '--serve' is used)")
+        ("input,i", po::value<std::string>(), "set input file (required unless '--batch' is used)")
         ("format,f", po::value<std::string>(), "set input file format (default: standard)")
         ("output,o", po::value<std::string>(), "set JSON output file")
-        ("initial-solution,", po::value<std::string>(), "")
+        ("initial-solution,", po::value<std::string>(), "set initial solution file")
         ("certificate,c", po::value<std::string>(), "set certificate file")
         ("seed,s", po::value<Seed>(), "set seed")
         ("time-limit,t", po::value<double>(), "set time limit in seconds")
@@ -182,6 +690,19 @@ int main(int argc, char *argv[])
         ("only-write-at-the-end,e", "only write output and certificate files at the end")
         ("log,l", po::value<std::string>(), "set log file")
         ("log-to-stderr", "write log to stderr")
+        ("clique-lower-bound,", po::value<bool>(), "compute a clique lower bound and stop at the first optimal solution (default: 0 for the greedy algorithms, 1 otherwise)")
+        ("clique-lower-bound-number-of-threads,", po::value<int>(), "set the number of threads used to compute the clique lower bound (default: 1)")
+        ("relabeling,", po::value<VertexRelabeling>(), "set the relabeling of the vertices applied when reading the instance (default: none)")
+        ("write-binary-cache,", po::value<std::string>(), "write the instance in binary format, to be read with '--format binary'")
+        ("remove-duplicate-edges,", "remove the edges which appear several times in the input file")
+        ("number-of-reading-threads,", po::value<int>(), "set the number of threads used to parse the input file (snap, matrixmarket, dimacs)")
+        ("batch,", po::value<std::string>(), "solve all the instances of a CSV manifest instead of '--input'")
+        ("batch-data-directory,", po::value<std::string>(), "set the directory of the instances of the manifest (default: directory of the manifest)")
+        ("batch-certificate-directory,", po::value<std::string>(), "set the directory where the certificates of the batch are written")
+        ("batch-number-of-threads,", po::value<int>(), "set the number of instances solved in parallel (default: number of hardware threads)")
+        ("serve,", "read requests as line-delimited JSON on stdin and write events on stdout")
+        ("serve-number-of-threads,", po::value<int>(), "set the number of requests solved in parallel (default: 1)")
+        ("serve-cache-size,", po::value<int>(), "set the number of instances read from files kept in memory by the server (default: 8)")
 
         ("ordering,", po::value<Ordering>(), "set the ordering (greedy)")
         ("reverse,", po::value<bool>(), "set reverse (greedy)")
@@ -190,8 +711,18 @@ int main(int argc, char *argv[])
         ("hybrid,", po::value<bool>(), "use hybrid model (MILP partial ordering)")
         ("maximum-number-of-iterations,", po::value<int>(), "set the maximum number of iterations (local search)")
         ("maximum-number-of-iterations-without-improvement,", po::value<int>(), "set the maximum number of iterations without improvement (local search)")
+        ("penalty-decay-threshold,", po::value<int>(), "set the penalty above which all the penalties are halved (local search)")
+        ("number-of-threads,", po::value<int>(), "set the number of threads (greedy, local search portfolio)")
         ("linear-programming-solver", po::value<columngenerationsolver::SolverName>(), "set linear programming solver (column generation)")
+        ("maximum-number-of-columns-per-pricing,", po::value<int>(), "set the maximum number of columns generated by each pricing (column generation)")
         ;
+    return desc;
+}
+
+int main(int argc, char *argv[])
+{
+    // Parse program options
+    po::options_description desc = program_options();
     po::variables_map vm;
     po::store(po::parse_command_line(argc, argv, desc), vm);
     if (vm.count("help")) {
@@ -205,10 +736,45 @@ int main(int argc, char *argv[])
         return 1;
     }
 
+    // Server mode.
+    if (vm.count("serve")) {
+        Server server(
+                vm,
+                (vm.count("serve-number-of-threads"))?
+                vm["serve-number-of-threads"].as<int>(): 1,
+                (vm.count("serve-cache-size"))?
+                vm["serve-cache-size"].as<int>(): 8);
+        server.serve();
+        return 0;
+    }
+    if (!vm.count("algorithm")) {
+        std::cout << desc << std::endl;;
+        return 1;
+    }
+
+    // Batch mode.
+    if (vm.count("batch")) {
+        if (vm.count("input") || vm.count("initial-solution") || vm.count("certificate")) {
+            throw std::invalid_argument(
+                    "'--batch' can't be used with '--input', '--initial-solution'"
+                    " or '--certificate'.");
+        }
+        run_batch(vm);
+        return 0;
+    }
+    if (!vm.count("input")) {
+        std::cout << desc << std::endl;;
+        return 1;
+    }
+
     // Build instance.
     const Instance instance(
             vm["input"].as<std::string>(),
-            (vm.count("format")? vm["format"].as<std::string>(): "dimacs"));
+            (vm.count("format")? vm["format"].as<std::string>(): "dimacs"),
+            read_instance_args(vm));
+
+    if (vm.count("write-binary-cache"))
+        instance.write_binary(vm["write-binary-cache"].as<std::string>());
 
     // Run.
     Output output = run(instance, vm);
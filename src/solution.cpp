@@ -8,11 +8,14 @@ using namespace coloringsolver;
 Solution::Solution(const Instance& instance):
     instance_(&instance),
     map_(
-            instance.graph().number_of_vertices(),
+            instance.number_of_vertices(),
             std::max(
-                instance.graph().highest_degree(),
-                instance.graph().number_of_vertices())),
-    number_of_conflicts_(instance.graph().number_of_vertices(), 0)
+                instance.highest_degree(),
+                instance.number_of_vertices())),
+    conflicts_((instance.compact_graph() != nullptr
+                || instance.adjacency_list_graph() != nullptr)?
+            instance.number_of_edges(): 0),
+    number_of_conflicts_(instance.number_of_vertices(), 0)
 {
 }
 
@@ -29,12 +32,16 @@ Solution::Solution(
                 "Unable to open file \"" + certificate_path + "\".");
     }
 
+    // The certificate uses the vertex ids of the instance file.
+    // A certificate may be partial: the vertices after its end and the ones
+    // with color '-1' are left uncolored.
     ColorId color_id;
-    for (VertexId vertex_id = 0;
-            vertex_id < instance.graph().number_of_vertices();
-            ++vertex_id) {
-        file >> color_id;
-        set(vertex_id, color_id);
+    for (VertexId original_vertex_id = 0;
+            original_vertex_id < instance.number_of_vertices();
+            ++original_vertex_id) {
+        if (!(file >> color_id))
+            break;
+        set(instance.vertex_id(original_vertex_id), color_id);
     }
 }
 
@@ -44,7 +51,7 @@ std::ostream& Solution::format(
 {
     if (verbosity_level >= 1) {
         os
-            << "Number of vertices:   " << optimizationtools::Ratio<VertexId>(number_of_vertices(), instance().graph().number_of_vertices()) << std::endl
+            << "Number of vertices:   " << optimizationtools::Ratio<VertexId>(number_of_vertices(), instance().number_of_vertices()) << std::endl
             << "Number of conflicts:  " << number_of_conflicts() << std::endl
             << "Feasible:             " << feasible() << std::endl
             << "Number of colors:     " << number_of_colors() << std::endl
@@ -59,12 +66,12 @@ std::ostream& Solution::format(
             << std::setw(12) << "------"
             << std::setw(12) << "-----"
             << std::endl;
-        for (VertexId vertex_id = 0;
-                vertex_id < instance().graph().number_of_vertices();
-                ++vertex_id) {
+        for (VertexId original_vertex_id = 0;
+                original_vertex_id < instance().number_of_vertices();
+                ++original_vertex_id) {
             os
-                << std::setw(12) << vertex_id
-                << std::setw(12) << color(vertex_id)
+                << std::setw(12) << original_vertex_id
+                << std::setw(12) << color(instance().vertex_id(original_vertex_id))
                 << std::endl;
         }
     }
@@ -82,10 +89,11 @@ void Solution::write(const std::string& certificate_path) const
                 "Unable to open file \"" + certificate_path + "\".");
     }
 
-    for (VertexId vertex_id = 0;
-            vertex_id < instance().graph().number_of_vertices();
-            ++vertex_id)
-        file << color(vertex_id) << std::endl;
+    for (VertexId original_vertex_id = 0;
+            original_vertex_id < instance().number_of_vertices();
+            ++original_vertex_id) {
+        file << color(instance().vertex_id(original_vertex_id)) << std::endl;
+    }
     file.close();
 }
 
@@ -0,0 +1,41 @@
+#include "tests.hpp"
+#include "coloringsolver/clique.hpp"
+
+using namespace coloringsolver;
+
+TEST_P(InstanceTest, GreedyClique)
+{
+    const Instance instance = get_instance(GetParam());
+    const optimizationtools::AbstractGraph& graph = instance.graph();
+    VertexId n = graph.number_of_vertices();
+    for (Counter number_of_threads: {1, 3}) {
+        std::vector<VertexId> clique = greedy_clique(instance, number_of_threads);
+        if (n > 0) {
+            EXPECT_GE(clique.size(), 1);
+        }
+        EXPECT_LE((VertexPos)clique.size(), instance.degeneracy() + 1);
+        // The vertices are distinct and pairwise adjacent.
+        std::vector<Counter> marks(n, -1);
+        for (VertexPos pos = 0; pos < (VertexPos)clique.size(); ++pos) {
+            VertexId vertex_id = clique[pos];
+            ASSERT_GE(vertex_id, 0);
+            ASSERT_LT(vertex_id, n);
+            for (auto it = graph.neighbors_begin(vertex_id);
+                    it != graph.neighbors_end(vertex_id);
+                    ++it) {
+                marks[*it] = pos;
+            }
+            for (VertexPos pos_2 = 0; pos_2 < pos; ++pos_2) {
+                EXPECT_NE(clique[pos_2], vertex_id);
+                EXPECT_EQ(marks[clique[pos_2]], pos)
+                    << "threads " << number_of_threads;
+            }
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        Clique,
+        InstanceTest,
+        testing::ValuesIn(get_test_instance_paths(get_path({"data", "test_all.txt"}))),
+        get_instance_test_name);
@@ -0,0 +1,138 @@
+#include "tests.hpp"
+#include "coloringsolver/algorithms/greedy.hpp"
+
+using namespace coloringsolver;
+
+TEST_P(InstanceTest, GreedyFeasible)
+{
+    const Instance instance = get_instance(GetParam());
+    for (Ordering ordering: {
+            Ordering::Default,
+            Ordering::LargestFirst,
+            Ordering::IncidenceDegree,
+            Ordering::SmallestLast,
+            Ordering::DynamicLargestFirst}) {
+        for (bool reverse: {false, true}) {
+            for (Counter number_of_threads: {1, 4}) {
+                GreedyParameters parameters;
+                parameters.verbosity_level = 0;
+                parameters.ordering = ordering;
+                parameters.reverse = reverse;
+                parameters.number_of_threads = number_of_threads;
+                Output output = greedy(instance, parameters);
+                EXPECT_TRUE(output.solution.feasible())
+                    << "ordering " << ordering
+                    << " reverse " << reverse
+                    << " threads " << number_of_threads;
+            }
+        }
+    }
+}
+
+TEST_P(InstanceTest, GreedyDsaturFeasible)
+{
+    const Instance instance = get_instance(GetParam());
+    GreedyDsaturParameters parameters;
+    parameters.verbosity_level = 0;
+    Output output = greedy_dsatur(instance, parameters);
+    EXPECT_TRUE(output.solution.feasible());
+}
+
+TEST_P(InstanceTest, GreedyJonesPlassmannDeterministic)
+{
+    // The solution only depends on the generator, not on the number of
+    // threads.
+    const Instance instance = get_instance(GetParam());
+    std::vector<ColorId> colors;
+    for (Counter number_of_threads: {1, 2, 4}) {
+        GreedyJonesPlassmannParameters parameters;
+        parameters.verbosity_level = 0;
+        parameters.number_of_threads = number_of_threads;
+        std::mt19937_64 generator(0);
+        Output output = greedy_jones_plassmann(instance, generator, parameters);
+        EXPECT_TRUE(output.solution.feasible())
+            << "threads " << number_of_threads;
+        std::vector<ColorId> colors_cur;
+        for (VertexId vertex_id = 0;
+                vertex_id < instance.graph().number_of_vertices();
+                ++vertex_id) {
+            colors_cur.push_back(output.solution.color(vertex_id));
+        }
+        if (number_of_threads == 1) {
+            colors = colors_cur;
+        } else {
+            EXPECT_EQ(colors_cur, colors)
+                << "threads " << number_of_threads;
+        }
+    }
+}
+
+TEST_P(InstanceTest, GreedyRepair)
+{
+    const Instance instance = get_instance(GetParam());
+    VertexId n = instance.graph().number_of_vertices();
+    GreedyParameters greedy_parameters;
+    greedy_parameters.verbosity_level = 0;
+    Solution solution = greedy(instance, greedy_parameters).solution;
+    Parameters parameters;
+    parameters.verbosity_level = 0;
+
+    // Partial seed: every third vertex is uncolored. The other vertices keep
+    // their color classes.
+    Solution solution_partial(instance);
+    for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id)
+        if (vertex_id % 3 != 0)
+            solution_partial.set(vertex_id, solution.color(vertex_id));
+    Output output = greedy_repair(solution_partial, parameters);
+    EXPECT_TRUE(output.solution.feasible());
+    for (VertexId vertex_id_1 = 1; vertex_id_1 < n; ++vertex_id_1) {
+        if (vertex_id_1 % 3 == 0)
+            continue;
+        for (VertexId vertex_id_2 = vertex_id_1 + 1; vertex_id_2 < n; ++vertex_id_2) {
+            if (vertex_id_2 % 3 == 0)
+                continue;
+            EXPECT_EQ(
+                    output.solution.color(vertex_id_1) == output.solution.color(vertex_id_2),
+                    solution.color(vertex_id_1) == solution.color(vertex_id_2));
+        }
+    }
+
+    // Infeasible seeds: a single color, and random colors among 3.
+    Solution solution_single_color(instance);
+    Solution solution_random(instance);
+    std::mt19937_64 generator(0);
+    std::uniform_int_distribution<ColorId> d_c(0, (std::min)((ColorId)n, (ColorId)3) - 1);
+    for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id) {
+        solution_single_color.set(vertex_id, 0);
+        solution_random.set(vertex_id, d_c(generator));
+    }
+    for (const Solution* initial_solution: {&solution_single_color, &solution_random}) {
+        output = greedy_repair(*initial_solution, parameters);
+        EXPECT_TRUE(output.solution.feasible());
+    }
+}
+
+TEST(GreedyDsatur, MoreThan64Colors)
+{
+    // A complete graph needs one color per vertex, so the adjacent color
+    // sets have to grow several times.
+    VertexId n = 150;
+    optimizationtools::AdjacencyListGraphBuilder graph_builder;
+    for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id)
+        graph_builder.add_vertex();
+    for (VertexId vertex_id_1 = 0; vertex_id_1 < n; ++vertex_id_1)
+        for (VertexId vertex_id_2 = vertex_id_1 + 1; vertex_id_2 < n; ++vertex_id_2)
+            graph_builder.add_edge(vertex_id_1, vertex_id_2);
+    Instance instance(std::make_shared<const optimizationtools::AdjacencyListGraph>(graph_builder.build()));
+    GreedyDsaturParameters parameters;
+    parameters.verbosity_level = 0;
+    Output output = greedy_dsatur(instance, parameters);
+    EXPECT_TRUE(output.solution.feasible());
+    EXPECT_EQ(output.solution.number_of_colors(), n);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        Greedy,
+        InstanceTest,
+        testing::ValuesIn(get_test_instance_paths(get_path({"data", "test_all.txt"}))),
+        get_instance_test_name);
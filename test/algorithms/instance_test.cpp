@@ -0,0 +1,265 @@
+#include "tests.hpp"
+
+#include <boost/filesystem.hpp>
+
+using namespace coloringsolver;
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+/** Get the sorted neighbors of a vertex given by its original id. */
+std::vector<VertexId> get_original_neighbors(
+        const Instance& instance,
+        VertexId original_vertex_id)
+{
+    const optimizationtools::AbstractGraph& graph = instance.graph();
+    VertexId vertex_id = instance.vertex_id(original_vertex_id);
+    std::vector<VertexId> neighbors;
+    for (auto it = graph.neighbors_begin(vertex_id);
+            it != graph.neighbors_end(vertex_id);
+            ++it) {
+        neighbors.push_back(instance.original_vertex_id(*it));
+    }
+    std::sort(neighbors.begin(), neighbors.end());
+    return neighbors;
+}
+
+/** Check that two instances have the same graph up to the vertex ids. */
+void expect_same_graph(
+        const Instance& instance_1,
+        const Instance& instance_2)
+{
+    VertexId n = instance_1.graph().number_of_vertices();
+    ASSERT_EQ(instance_2.graph().number_of_vertices(), n);
+    ASSERT_EQ(instance_2.graph().number_of_edges(), instance_1.graph().number_of_edges());
+    for (VertexId original_vertex_id = 0; original_vertex_id < n; ++original_vertex_id) {
+        EXPECT_EQ(
+                get_original_neighbors(instance_1, original_vertex_id),
+                get_original_neighbors(instance_2, original_vertex_id))
+            << "vertex " << original_vertex_id;
+    }
+}
+
+/** Overwrite bytes of a file. */
+void overwrite(
+        const std::string& path,
+        std::size_t pos,
+        const void* data,
+        std::size_t size)
+{
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(pos);
+    file.write(static_cast<const char*>(data), size);
+}
+
+}
+
+TEST_P(InstanceTest, BinaryRoundTrip)
+{
+    TestInstancePath files = GetParam();
+    std::string instance_path = get_path({"data", files.instance_path});
+    std::string binary_path = (fs::temp_directory_path() / fs::unique_path()).string();
+    for (VertexRelabeling vertex_relabeling: {
+            VertexRelabeling::None,
+            VertexRelabeling::ReverseCuthillMcKee}) {
+        InstanceReadParameters read_parameters;
+        read_parameters.vertex_relabeling = vertex_relabeling;
+        Instance instance(instance_path, files.instance_format, read_parameters);
+        if (instance.graph().number_of_vertices() == 0)
+            continue;
+        instance.write_binary(binary_path);
+        Instance instance_binary(binary_path, "binary");
+        fs::remove(binary_path);
+
+        EXPECT_EQ(instance_binary.relabeled(), instance.relabeled());
+        expect_same_graph(instance, instance_binary);
+        // The edge ids are kept.
+        const optimizationtools::AdjacencyListGraph& graph = *instance.adjacency_list_graph();
+        const optimizationtools::AdjacencyListGraph& graph_binary = *instance_binary.adjacency_list_graph();
+        for (EdgeId edge_id = 0; edge_id < graph.number_of_edges(); ++edge_id) {
+            EXPECT_EQ(graph_binary.first_end(edge_id), graph.first_end(edge_id));
+            EXPECT_EQ(graph_binary.second_end(edge_id), graph.second_end(edge_id));
+        }
+        EXPECT_EQ(instance_binary.degeneracy(), instance.degeneracy());
+    }
+}
+
+TEST_P(InstanceTest, ReadParallel)
+{
+    TestInstancePath files = GetParam();
+    std::string instance_path = get_path({"data", files.instance_path});
+    for (bool remove_duplicate_edges: {false, true}) {
+        InstanceReadParameters read_parameters;
+        read_parameters.remove_duplicate_edges = remove_duplicate_edges;
+        Instance instance(instance_path, files.instance_format, read_parameters);
+        read_parameters.number_of_threads = 3;
+        Instance instance_parallel(instance_path, files.instance_format, read_parameters);
+        expect_same_graph(instance, instance_parallel);
+    }
+}
+
+TEST_P(InstanceTest, Relabel)
+{
+    TestInstancePath files = GetParam();
+    std::string instance_path = get_path({"data", files.instance_path});
+    Instance instance(instance_path, files.instance_format);
+    VertexId n = instance.graph().number_of_vertices();
+    std::string certificate_path = (fs::temp_directory_path() / fs::unique_path()).string();
+    for (VertexRelabeling vertex_relabeling: {
+            VertexRelabeling::ReverseCuthillMcKee,
+            VertexRelabeling::DegreeDescending,
+            VertexRelabeling::BreadthFirstSearch}) {
+        InstanceReadParameters read_parameters;
+        read_parameters.vertex_relabeling = vertex_relabeling;
+        Instance instance_relabeled(instance_path, files.instance_format, read_parameters);
+        expect_same_graph(instance, instance_relabeled);
+        for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id) {
+            EXPECT_EQ(
+                    instance_relabeled.vertex_id(instance_relabeled.original_vertex_id(vertex_id)),
+                    vertex_id);
+        }
+
+        // Certificates use the original vertex ids.
+        Solution solution(instance_relabeled);
+        for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id)
+            solution.set(vertex_id, instance_relabeled.original_vertex_id(vertex_id));
+        solution.write(certificate_path);
+        Solution solution_read(instance, certificate_path);
+        fs::remove(certificate_path);
+        for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id)
+            EXPECT_EQ(solution_read.color(vertex_id), vertex_id);
+    }
+}
+
+TEST_P(InstanceTest, CoreNumbers)
+{
+    const Instance instance = get_instance(GetParam());
+    const optimizationtools::AbstractGraph& graph = instance.graph();
+    VertexId n = graph.number_of_vertices();
+
+    // Peel the vertices by minimum degree.
+    std::vector<VertexId> degrees(n);
+    for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id)
+        degrees[vertex_id] = graph.degree(vertex_id);
+    std::vector<bool> removed(n, false);
+    std::vector<VertexPos> core_numbers(n);
+    VertexPos core_number = 0;
+    for (VertexPos pos = 0; pos < n; ++pos) {
+        VertexId vertex_id_min = -1;
+        for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id) {
+            if (!removed[vertex_id]
+                    && (vertex_id_min == -1
+                        || degrees[vertex_id] < degrees[vertex_id_min])) {
+                vertex_id_min = vertex_id;
+            }
+        }
+        core_number = (std::max)(core_number, degrees[vertex_id_min]);
+        core_numbers[vertex_id_min] = core_number;
+        removed[vertex_id_min] = true;
+        for (auto it = graph.neighbors_begin(vertex_id_min);
+                it != graph.neighbors_end(vertex_id_min);
+                ++it) {
+            degrees[*it]--;
+        }
+    }
+    for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id)
+        EXPECT_EQ(instance.core_number(vertex_id), core_numbers[vertex_id]);
+
+    // Each vertex has at most its core number of neighbors after it in the
+    // degeneracy ordering.
+    const std::vector<VertexId>& ordering = instance.degeneracy_ordering();
+    ASSERT_EQ((VertexId)ordering.size(), n);
+    std::vector<VertexPos> positions(n, -1);
+    for (VertexPos pos = 0; pos < n; ++pos)
+        positions[ordering[pos]] = pos;
+    for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id) {
+        ASSERT_NE(positions[vertex_id], -1);
+        VertexPos number_of_neighbors_after = 0;
+        for (auto it = graph.neighbors_begin(vertex_id);
+                it != graph.neighbors_end(vertex_id);
+                ++it) {
+            if (positions[*it] > positions[vertex_id])
+                number_of_neighbors_after++;
+        }
+        EXPECT_LE(number_of_neighbors_after, instance.core_number(vertex_id));
+    }
+}
+
+TEST(InstanceBinary, Weights)
+{
+    // Path 0-1-2-3 with weights 1, 2, 3, 4.
+    optimizationtools::AdjacencyListGraphBuilder graph_builder;
+    for (VertexId vertex_id = 0; vertex_id < 4; ++vertex_id)
+        graph_builder.add_vertex(vertex_id + 1);
+    for (VertexId vertex_id = 0; vertex_id < 3; ++vertex_id)
+        graph_builder.add_edge(vertex_id, vertex_id + 1);
+    Instance instance(std::make_shared<const optimizationtools::AdjacencyListGraph>(graph_builder.build()));
+    std::string binary_path = (fs::temp_directory_path() / fs::unique_path()).string();
+
+    instance.write_binary(binary_path);
+    Instance instance_binary(binary_path, "binary");
+    // The copies of an instance share its adjacency list graph.
+    Instance instance_binary_copy(instance_binary);
+    EXPECT_EQ(instance_binary_copy.adjacency_list_graph(), instance_binary.adjacency_list_graph());
+    for (VertexId vertex_id = 0; vertex_id < 4; ++vertex_id)
+        EXPECT_EQ(instance_binary.graph().weight(vertex_id), vertex_id + 1);
+
+    // The weights follow the vertices when they are relabeled.
+    InstanceReadParameters read_parameters;
+    read_parameters.vertex_relabeling = VertexRelabeling::DegreeDescending;
+    Instance instance_relabeled(binary_path, "binary", read_parameters);
+    for (VertexId vertex_id = 0; vertex_id < 4; ++vertex_id) {
+        EXPECT_EQ(
+                instance_relabeled.graph().weight(vertex_id),
+                instance_relabeled.original_vertex_id(vertex_id) + 1);
+    }
+
+    fs::remove(binary_path);
+}
+
+TEST(InstanceBinary, Corrupted)
+{
+    // Path 0-1-2-3.
+    optimizationtools::AdjacencyListGraphBuilder graph_builder;
+    for (VertexId vertex_id = 0; vertex_id < 4; ++vertex_id)
+        graph_builder.add_vertex();
+    for (VertexId vertex_id = 0; vertex_id < 3; ++vertex_id)
+        graph_builder.add_edge(vertex_id, vertex_id + 1);
+    Instance instance(std::make_shared<const optimizationtools::AdjacencyListGraph>(graph_builder.build()));
+    std::string binary_path = (fs::temp_directory_path() / fs::unique_path()).string();
+
+    // Sections: header (40 bytes), 5 offsets (40 bytes), then the 6
+    // neighbors.
+    const std::size_t offsets_pos = 40;
+    const std::size_t neighbors_pos = 80;
+
+    instance.write_binary(binary_path);
+    EXPECT_NO_THROW(Instance(binary_path, "binary"));
+
+    // Neighbor out of range.
+    uint32_t vertex_id = 4;
+    overwrite(binary_path, neighbors_pos, &vertex_id, sizeof(vertex_id));
+    EXPECT_THROW(Instance(binary_path, "binary"), std::runtime_error);
+
+    // Decreasing offsets.
+    instance.write_binary(binary_path);
+    EdgeId offset = 5;
+    overwrite(binary_path, offsets_pos + sizeof(EdgeId), &offset, sizeof(offset));
+    EXPECT_THROW(Instance(binary_path, "binary"), std::runtime_error);
+
+    // Wrong number of vertices.
+    instance.write_binary(binary_path);
+    uint64_t number_of_vertices = (uint64_t)1 << 40;
+    overwrite(binary_path, 8, &number_of_vertices, sizeof(number_of_vertices));
+    EXPECT_THROW(Instance(binary_path, "binary"), std::runtime_error);
+
+    fs::remove(binary_path);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        Instance,
+        InstanceTest,
+        testing::ValuesIn(get_test_instance_paths(get_path({"data", "test_all.txt"}))),
+        get_instance_test_name);
@@ -0,0 +1,75 @@
+#include "tests.hpp"
+#include "coloringsolver/algorithms/local_search_row_weighting.hpp"
+
+using namespace coloringsolver;
+
+TEST_P(InstanceTest, LocalSearchRowWeightingFeasible)
+{
+    const Instance instance = get_instance(GetParam());
+    std::mt19937_64 generator(0);
+    LocalSearchRowWeightingParameters parameters;
+    parameters.verbosity_level = 0;
+    parameters.maximum_number_of_iterations = 2000;
+    parameters.check_penalties = true;
+    Output output = local_search_row_weighting(instance, generator, parameters);
+    EXPECT_TRUE(output.solution.feasible());
+}
+
+TEST_P(InstanceTest, LocalSearchRowWeighting2Feasible)
+{
+    const Instance instance = get_instance(GetParam());
+    std::mt19937_64 generator(0);
+    LocalSearchRowWeighting2Parameters parameters;
+    parameters.verbosity_level = 0;
+    parameters.maximum_number_of_iterations = 2000;
+    parameters.check_penalties = true;
+    Output output = local_search_row_weighting_2(instance, generator, parameters);
+    EXPECT_TRUE(output.solution.feasible());
+}
+
+TEST_P(InstanceTest, LocalSearchRowWeightingPenaltyDecay)
+{
+    const Instance instance = get_instance(GetParam());
+    std::mt19937_64 generator(0);
+    LocalSearchRowWeightingParameters parameters;
+    parameters.verbosity_level = 0;
+    parameters.maximum_number_of_iterations = 500;
+    parameters.penalty_decay_threshold = 2;
+    parameters.check_penalties = true;
+    Output output = local_search_row_weighting(instance, generator, parameters);
+    EXPECT_TRUE(output.solution.feasible());
+}
+
+TEST_P(InstanceTest, LocalSearchRowWeighting2PenaltyDecay)
+{
+    const Instance instance = get_instance(GetParam());
+    std::mt19937_64 generator(0);
+    LocalSearchRowWeighting2Parameters parameters;
+    parameters.verbosity_level = 0;
+    parameters.maximum_number_of_iterations = 500;
+    parameters.penalty_decay_threshold = 2;
+    parameters.check_penalties = true;
+    Output output = local_search_row_weighting_2(instance, generator, parameters);
+    EXPECT_TRUE(output.solution.feasible());
+}
+
+TEST_P(InstanceTest, LocalSearchRowWeightingPortfolioFeasible)
+{
+    const Instance instance = get_instance(GetParam());
+    for (Counter number_of_threads: {1, 3}) {
+        std::mt19937_64 generator(0);
+        LocalSearchRowWeightingPortfolioParameters parameters;
+        parameters.verbosity_level = 0;
+        parameters.number_of_threads = number_of_threads;
+        parameters.maximum_number_of_iterations = 2000;
+        Output output = local_search_row_weighting_portfolio(instance, generator, parameters);
+        EXPECT_TRUE(output.solution.feasible())
+            << "threads " << number_of_threads;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        LocalSearchRowWeighting,
+        InstanceTest,
+        testing::ValuesIn(get_test_instance_paths(get_path({"data", "test_all.txt"}))),
+        get_instance_test_name);
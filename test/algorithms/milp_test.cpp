@@ -1,8 +1,195 @@
 #include "tests.hpp"
 #include "coloringsolver/algorithms/milp.hpp"
+#include "coloringsolver/algorithms/greedy.hpp"
 
 using namespace coloringsolver;
 
+namespace
+{
+
+/**
+ * Check that the MIP start of a model is an integer point satisfying the
+ * bounds of the variables and every row of the model.
+ */
+void expect_feasible_milp_start(
+        const MilpModel& milp_model,
+        double objective_value)
+{
+    const mathoptsolverscmake::MathOptModel& model = milp_model.model;
+    const std::vector<double>& milp_start = milp_model.milp_start;
+    const double tolerance = 1e-6;
+    int number_of_variables = model.variables_lower_bounds.size();
+    ASSERT_EQ((int)milp_start.size(), number_of_variables);
+
+    double value = 0;
+    for (int variable_id = 0; variable_id < number_of_variables; ++variable_id) {
+        double x = milp_start[variable_id];
+        EXPECT_GE(x, model.variables_lower_bounds[variable_id] - tolerance)
+            << "variable " << variable_id;
+        EXPECT_LE(x, model.variables_upper_bounds[variable_id] + tolerance)
+            << "variable " << variable_id;
+        EXPECT_NEAR(x, std::round(x), tolerance)
+            << "variable " << variable_id;
+        value += model.objective_coefficients[variable_id] * x;
+    }
+    EXPECT_NEAR(value, objective_value, tolerance);
+
+    int number_of_constraints = model.constraints_starts.size();
+    for (int constraint_id = 0; constraint_id < number_of_constraints; ++constraint_id) {
+        int element_end = (constraint_id + 1 < number_of_constraints)?
+            model.constraints_starts[constraint_id + 1]:
+            model.elements_variables.size();
+        double row_value = 0;
+        for (int element_id = model.constraints_starts[constraint_id];
+                element_id < element_end;
+                ++element_id) {
+            row_value += model.elements_coefficients[element_id]
+                * milp_start[model.elements_variables[element_id]];
+        }
+        EXPECT_GE(row_value, model.constraints_lower_bounds[constraint_id] - tolerance)
+            << "constraint " << constraint_id;
+        EXPECT_LE(row_value, model.constraints_upper_bounds[constraint_id] + tolerance)
+            << "constraint " << constraint_id;
+    }
+}
+
+/** Get the number of colors of the initial solution of the models. */
+ColorId get_initial_number_of_colors(const Instance& instance)
+{
+    GreedyDsaturParameters greedy_parameters;
+    greedy_parameters.verbosity_level = 0;
+    return greedy_dsatur(instance, greedy_parameters).solution.number_of_colors();
+}
+
+/**
+ * Check that the minimum objective value of the representatives model over
+ * all its 0/1 points is the chromatic number of the graph, and that its
+ * feasible points are proper colorings.
+ */
+void expect_representatives_model_exact(
+        VertexId number_of_vertices,
+        const std::vector<std::pair<VertexId, VertexId>>& edges,
+        ColorId chromatic_number)
+{
+    optimizationtools::AdjacencyListGraphBuilder graph_builder;
+    for (VertexId vertex_id = 0; vertex_id < number_of_vertices; ++vertex_id)
+        graph_builder.add_vertex();
+    for (const auto& edge: edges)
+        graph_builder.add_edge(edge.first, edge.second);
+    Instance instance(std::make_shared<const optimizationtools::AdjacencyListGraph>(graph_builder.build()));
+    const mathoptsolverscmake::MathOptModel model = milp_representatives_model(instance).model;
+
+    // Represented vertices of the variables.
+    int number_of_variables = model.variables_lower_bounds.size();
+    ASSERT_LE(number_of_variables, 20);
+    std::vector<VertexId> representatives(number_of_variables);
+    std::vector<VertexId> represented_vertices(number_of_variables);
+    std::vector<int> self_variable_ids(number_of_vertices, -1);
+    for (int variable_id = 0; variable_id < number_of_variables; ++variable_id) {
+        int vertex_id = -1;
+        int vertex_2_id = -1;
+        ASSERT_EQ(std::sscanf(
+                    model.variables_names[variable_id].c_str(),
+                    "x_{%d,%d}",
+                    &vertex_id,
+                    &vertex_2_id), 2);
+        representatives[variable_id] = vertex_id;
+        represented_vertices[variable_id] = vertex_2_id;
+        if (vertex_id == vertex_2_id)
+            self_variable_ids[vertex_id] = variable_id;
+    }
+    for (VertexId vertex_id = 0; vertex_id < number_of_vertices; ++vertex_id)
+        ASSERT_NE(self_variable_ids[vertex_id], -1);
+
+    const double tolerance = 1e-6;
+    int number_of_constraints = model.constraints_starts.size();
+    double objective_value_min = std::numeric_limits<double>::infinity();
+    std::vector<double> x(number_of_variables);
+    for (long point = 0; point < (1L << number_of_variables); ++point) {
+        for (int variable_id = 0; variable_id < number_of_variables; ++variable_id)
+            x[variable_id] = (point >> variable_id) & 1;
+        bool feasible = true;
+        for (int constraint_id = 0; constraint_id < number_of_constraints; ++constraint_id) {
+            int element_end = (constraint_id + 1 < number_of_constraints)?
+                model.constraints_starts[constraint_id + 1]:
+                model.elements_variables.size();
+            double row_value = 0;
+            for (int element_id = model.constraints_starts[constraint_id];
+                    element_id < element_end;
+                    ++element_id) {
+                row_value += model.elements_coefficients[element_id]
+                    * x[model.elements_variables[element_id]];
+            }
+            if (row_value < model.constraints_lower_bounds[constraint_id] - tolerance
+                    || row_value > model.constraints_upper_bounds[constraint_id] + tolerance) {
+                feasible = false;
+                break;
+            }
+        }
+        if (!feasible)
+            continue;
+
+        // Color each vertex with one of its representatives.
+        Solution solution(instance);
+        double objective_value = 0;
+        for (int variable_id = 0; variable_id < number_of_variables; ++variable_id) {
+            objective_value += model.objective_coefficients[variable_id] * x[variable_id];
+            if (x[variable_id] == 0)
+                continue;
+            VertexId vertex_id = representatives[variable_id];
+            VertexId vertex_2_id = represented_vertices[variable_id];
+            // A vertex only represents vertices if it represents itself.
+            EXPECT_EQ(x[self_variable_ids[vertex_id]], 1) << "point " << point;
+            if (!solution.contains(vertex_2_id))
+                solution.set(vertex_2_id, vertex_id);
+        }
+        EXPECT_TRUE(solution.feasible()) << "point " << point;
+        // A vertex may have several representatives, therefore, the coloring
+        // may use fewer colors than there are representatives.
+        EXPECT_GE(objective_value, solution.number_of_colors() - tolerance)
+            << "point " << point;
+        objective_value_min = (std::min)(objective_value_min, objective_value);
+    }
+    EXPECT_NEAR(objective_value_min, chromatic_number, tolerance);
+}
+
+}
+
+TEST_P(InstanceTest, MilpAssignmentStart)
+{
+    const Instance instance = get_instance(GetParam());
+    ColorId number_of_colors = get_initial_number_of_colors(instance);
+    for (bool break_symmetries: {false, true}) {
+        MilpAssignmentParameters milp_parameters;
+        milp_parameters.break_symmetries = break_symmetries;
+        MilpModel milp_model = milp_assignment_model(instance, milp_parameters);
+        expect_feasible_milp_start(milp_model, number_of_colors);
+    }
+}
+
+TEST_P(InstanceTest, MilpRepresentativesStart)
+{
+    const Instance instance = get_instance(GetParam());
+    ColorId number_of_colors = get_initial_number_of_colors(instance);
+    MilpModel milp_model = milp_representatives_model(instance);
+    expect_feasible_milp_start(milp_model, number_of_colors);
+}
+
+TEST_P(InstanceTest, MilpPartialOrderingStart)
+{
+    const Instance instance = get_instance(GetParam());
+    if (instance.number_of_vertices() == 0)
+        return;
+    // The objective is the color of vertex 0, which has the largest color.
+    ColorId number_of_colors = get_initial_number_of_colors(instance);
+    for (bool hybrid: {false, true}) {
+        MilpPartialOrderingParameters milp_parameters;
+        milp_parameters.hybrid = hybrid;
+        MilpModel milp_model = milp_partial_ordering_model(instance, milp_parameters);
+        expect_feasible_milp_start(milp_model, number_of_colors - 1);
+    }
+}
+
 TEST_P(ExactAlgorithmTest, ExactAlgorithm)
 {
     TestParams test_params = GetParam();
@@ -17,6 +204,16 @@ TEST_P(ExactAlgorithmTest, ExactAlgorithm)
     EXPECT_EQ(output.bound, solution.objective_value());
 }
 
+TEST(MilpRepresentatives, IsolatedVertices)
+{
+    // Isolated vertices only.
+    expect_representatives_model_exact(3, {}, 1);
+    // Isolated vertices 0 and 4 around the triangle 1-2-3.
+    expect_representatives_model_exact(5, {{1, 2}, {2, 3}, {1, 3}}, 3);
+    // Isolated vertex 2 between the edges 0-1 and 3-4.
+    expect_representatives_model_exact(5, {{0, 1}, {3, 4}}, 2);
+}
+
 INSTANTIATE_TEST_SUITE_P(
         ColoringMilpAssignment,
         ExactAlgorithmTest,
@@ -85,3 +282,9 @@ INSTANTIATE_TEST_SUITE_P(
                     get_test_instance_paths(get_path({"data", "test_milp_partial_ordering_hybrid.txt"})),
                 })),
         get_test_name);
+
+INSTANTIATE_TEST_SUITE_P(
+        Milp,
+        InstanceTest,
+        testing::ValuesIn(get_test_instance_paths(get_path({"data", "test_all.txt"}))),
+        get_instance_test_name);
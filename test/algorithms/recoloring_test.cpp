@@ -0,0 +1,86 @@
+#include "tests.hpp"
+#include "coloringsolver/algorithms/greedy.hpp"
+#include "coloringsolver/algorithms/recoloring.hpp"
+
+using namespace coloringsolver;
+
+TEST_P(InstanceTest, RecolorFeasible)
+{
+    const Instance instance = get_instance(GetParam());
+    const optimizationtools::AbstractGraph& graph = instance.graph();
+    VertexId n = graph.number_of_vertices();
+    GreedyParameters greedy_parameters;
+    greedy_parameters.verbosity_level = 0;
+    Solution solution = greedy(instance, greedy_parameters).solution;
+
+    // Remove the first vertex and one edge of every tenth vertex, add two
+    // vertices and random edges.
+    std::mt19937_64 generator(0);
+    GraphDelta graph_delta;
+    graph_delta.number_of_added_vertices = 2;
+    if (n > 0)
+        graph_delta.removed_vertices.push_back(instance.original_vertex_id(0));
+    for (VertexId vertex_id = 0; vertex_id < n; vertex_id += 10) {
+        if (graph.degree(vertex_id) == 0)
+            continue;
+        graph_delta.removed_edges.push_back({
+                instance.original_vertex_id(vertex_id),
+                instance.original_vertex_id(*graph.neighbors_begin(vertex_id))});
+    }
+    graph_delta.added_edges.push_back({n, n + 1});
+    std::uniform_int_distribution<VertexId> d_v(1, n + 1);
+    for (Counter edge_pos = 0; n > 1 && edge_pos < 2 * n; ++edge_pos) {
+        VertexId vertex_id_1 = d_v(generator);
+        VertexId vertex_id_2 = d_v(generator);
+        if (vertex_id_1 != vertex_id_2)
+            graph_delta.added_edges.push_back({vertex_id_1, vertex_id_2});
+    }
+
+    for (VertexId maximum_kempe_chain_size: {0, 1024}) {
+        RecolorParameters parameters;
+        parameters.verbosity_level = 0;
+        parameters.maximum_kempe_chain_size = maximum_kempe_chain_size;
+        RecolorOutput output = recolor(solution, graph_delta, generator, parameters);
+        EXPECT_EQ(
+                output.instance->graph().number_of_vertices(),
+                n + 2 - (VertexId)graph_delta.removed_vertices.size());
+        EXPECT_TRUE(output.solution.feasible())
+            << "maximum Kempe chain size " << maximum_kempe_chain_size;
+    }
+}
+
+TEST(Recolor, KempeChainInterchange)
+{
+    // Edges 0-1 and 2-3 colored with 2 colors; the added vertex 4 is
+    // adjacent to 0 and 2 which have different colors. Swapping the colors
+    // of the chain {0, 1} frees a color for it.
+    optimizationtools::AdjacencyListGraphBuilder graph_builder;
+    for (VertexId vertex_id = 0; vertex_id < 4; ++vertex_id)
+        graph_builder.add_vertex();
+    graph_builder.add_edge(0, 1);
+    graph_builder.add_edge(2, 3);
+    Instance instance(std::make_shared<const optimizationtools::AdjacencyListGraph>(graph_builder.build()));
+    Solution solution(instance);
+    solution.set(0, 0);
+    solution.set(1, 1);
+    solution.set(2, 1);
+    solution.set(3, 0);
+
+    GraphDelta graph_delta;
+    graph_delta.number_of_added_vertices = 1;
+    graph_delta.added_edges = {{4, 0}, {4, 2}};
+    std::mt19937_64 generator(0);
+    RecolorParameters parameters;
+    parameters.verbosity_level = 0;
+    RecolorOutput output = recolor(solution, graph_delta, generator, parameters);
+    EXPECT_TRUE(output.solution.feasible());
+    EXPECT_EQ(output.solution.number_of_colors(), 2);
+    EXPECT_EQ(output.number_of_kempe_chain_interchanges, 1);
+    EXPECT_EQ(output.number_of_recolored_vertices, 1);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        Recolor,
+        InstanceTest,
+        testing::ValuesIn(get_test_instance_paths(get_path({"data", "test_all.txt"}))),
+        get_instance_test_name);
@@ -0,0 +1,92 @@
+#include "tests.hpp"
+
+using namespace coloringsolver;
+
+namespace
+{
+
+/** Check the conflicts of a solution against a scan of all the edges. */
+void expect_consistent_conflicts(const Solution& solution)
+{
+    const optimizationtools::AdjacencyListGraph& graph = *solution.instance().adjacency_list_graph();
+    VertexId n = graph.number_of_vertices();
+    std::vector<bool> conflicting(graph.number_of_edges(), false);
+    std::vector<VertexPos> number_of_conflicts(n, 0);
+    EdgeId total_number_of_conflicts = 0;
+    for (EdgeId edge_id = 0; edge_id < graph.number_of_edges(); ++edge_id) {
+        VertexId vertex_id_1 = graph.first_end(edge_id);
+        VertexId vertex_id_2 = graph.second_end(edge_id);
+        if (solution.contains(vertex_id_1)
+                && solution.contains(vertex_id_2)
+                && solution.color(vertex_id_1) == solution.color(vertex_id_2)) {
+            conflicting[edge_id] = true;
+            number_of_conflicts[vertex_id_1]++;
+            number_of_conflicts[vertex_id_2]++;
+            total_number_of_conflicts++;
+        }
+    }
+    ASSERT_EQ(solution.number_of_conflicts(), total_number_of_conflicts);
+    ASSERT_EQ((EdgeId)solution.conflicts().size(), total_number_of_conflicts);
+    // Each position holds a distinct conflicting edge.
+    std::vector<bool> seen(graph.number_of_edges(), false);
+    for (EdgePos edge_pos = 0; edge_pos < total_number_of_conflicts; ++edge_pos) {
+        EdgeId edge_id = solution.conflict(edge_pos);
+        ASSERT_GE(edge_id, 0);
+        ASSERT_LT(edge_id, graph.number_of_edges());
+        EXPECT_TRUE(conflicting[edge_id]);
+        EXPECT_FALSE(seen[edge_id]);
+        EXPECT_TRUE(solution.conflicts().contains(edge_id));
+        seen[edge_id] = true;
+    }
+    for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id) {
+        EXPECT_EQ(
+                solution.conflicting_vertices().contains(vertex_id),
+                number_of_conflicts[vertex_id] > 0);
+        if (number_of_conflicts[vertex_id] > 0) {
+            EXPECT_EQ(
+                    solution.conflicting_vertices()[vertex_id],
+                    number_of_conflicts[vertex_id]);
+        }
+    }
+}
+
+}
+
+TEST_P(InstanceTest, SolutionConflicts)
+{
+    const Instance instance = get_instance(GetParam());
+    if (instance.adjacency_list_graph() == nullptr)
+        return;
+    VertexId n = instance.graph().number_of_vertices();
+    if (n == 0)
+        return;
+
+    // Recolor random vertices with few colors, so that conflicts are added
+    // and removed, and uncolor some of them.
+    Solution solution(instance);
+    std::mt19937_64 generator(0);
+    std::uniform_int_distribution<VertexId> d_v(0, n - 1);
+    ColorId number_of_colors = (std::min)((ColorId)n, (ColorId)3);
+    std::uniform_int_distribution<ColorId> d_c(-1, number_of_colors - 1);
+    for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id)
+        solution.set(vertex_id, vertex_id % number_of_colors);
+    expect_consistent_conflicts(solution);
+    for (Counter iteration = 0; iteration < 200; ++iteration) {
+        solution.set(d_v(generator), d_c(generator));
+        if (iteration % 20 == 0)
+            expect_consistent_conflicts(solution);
+    }
+    expect_consistent_conflicts(solution);
+
+    // Remove all the conflicts.
+    for (VertexId vertex_id = 0; vertex_id < n; ++vertex_id)
+        solution.set(vertex_id, vertex_id);
+    expect_consistent_conflicts(solution);
+    EXPECT_TRUE(solution.feasible());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        Solution,
+        InstanceTest,
+        testing::ValuesIn(get_test_instance_paths(get_path({"data", "test_all.txt"}))),
+        get_instance_test_name);
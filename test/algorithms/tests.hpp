@@ -56,4 +56,12 @@ inline std::string get_test_name(const testing::TestParamInfo<TestParams>& info)
 
 class ExactAlgorithmTest: public testing::TestWithParam<TestParams> { };
 
+inline std::string get_instance_test_name(const testing::TestParamInfo<TestInstancePath>& info)
+{
+    return make_gtest_name(info.param.instance_path);
+}
+
+/** Test run on each instance of a list, without expected solution. */
+class InstanceTest: public testing::TestWithParam<TestInstancePath> { };
+
 }